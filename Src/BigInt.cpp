@@ -0,0 +1,185 @@
+#include <BigInt.hpp>
+
+#include <stdexcept>
+
+namespace lab {
+
+BigInt::BigInt(int64_t value)
+    : _magnitude(value < 0 ? uint64_t{0} - static_cast<uint64_t>(value) : static_cast<uint64_t>(value))
+    , _negative(value < 0)
+{ }
+
+BigInt::BigInt(BigNum magnitude, bool negative)
+    : _magnitude(std::move(magnitude))
+    , _negative(negative)
+{
+    _normalize();
+}
+
+BigInt::BigInt(std::string_view num_str) {
+    _negative = !num_str.empty() && num_str.front() == '-';
+    if (_negative) {
+        num_str.remove_prefix(1);
+    }
+    _magnitude = BigNum(num_str);
+    _normalize();
+}
+
+const BigNum& BigInt::magnitude() const noexcept {
+    return _magnitude;
+}
+
+bool BigInt::isNegative() const noexcept {
+    return _negative;
+}
+
+int BigInt::sign() const noexcept {
+    if (_negative) {
+        return -1;
+    }
+    return _magnitude == 0 ? 0 : 1;
+}
+
+BigInt BigInt::operator-() const {
+    return BigInt(_magnitude, !_negative);
+}
+
+BigInt& BigInt::operator+=(const BigInt& right) {
+    if (_negative == right._negative) {
+        _magnitude += right._magnitude;
+    } else if (_magnitude >= right._magnitude) {
+        _magnitude -= right._magnitude;
+    } else {
+        /// |right| - |this| takes sign of right
+        _magnitude = right._magnitude - _magnitude;
+        _negative = right._negative;
+    }
+    _normalize();
+    return *this;
+}
+
+BigInt& BigInt::operator-=(const BigInt& right) {
+    return *this += -right;
+}
+
+BigInt& BigInt::operator*=(const BigInt& right) {
+    _magnitude *= right._magnitude;
+    _negative = _negative != right._negative;
+    _normalize();
+    return *this;
+}
+
+BigInt& BigInt::operator/=(const BigInt& right) {
+    *this = std::move(divideTruncated(*this, right).first);
+    return *this;
+}
+
+BigInt& BigInt::operator%=(const BigInt& right) {
+    *this = std::move(divideTruncated(*this, right).second);
+    return *this;
+}
+
+BigInt operator+(BigInt left, const BigInt& right) {
+    left += right;
+    return left;
+}
+
+BigInt operator-(BigInt left, const BigInt& right) {
+    left -= right;
+    return left;
+}
+
+BigInt operator*(const BigInt& left, const BigInt& right) {
+    return BigInt(left._magnitude * right._magnitude, left._negative != right._negative);
+}
+
+BigInt operator/(const BigInt& left, const BigInt& right) {
+    return divideTruncated(left, right).first;
+}
+
+BigInt operator%(const BigInt& left, const BigInt& right) {
+    return divideTruncated(left, right).second;
+}
+
+std::pair<BigInt, BigInt> divideTruncated(const BigInt& left, const BigInt& right) {
+    auto [quotient, remainder] = extract(left._magnitude, right._magnitude);
+    return {BigInt(std::move(quotient), left._negative != right._negative),
+            BigInt(std::move(remainder), left._negative)};
+}
+
+std::pair<BigInt, BigInt> divideFloored(const BigInt& left, const BigInt& right) {
+    auto [quotient, remainder] = divideTruncated(left, right);
+    if (remainder.sign() != 0 && left._negative != right._negative) {
+        quotient -= 1;
+        remainder += right;
+    }
+    return {std::move(quotient), std::move(remainder)};
+}
+
+BigNum residue(const BigInt& num, const BigNum& mod) {
+    auto result = num._magnitude % mod;
+    if (num._negative && result != 0) {
+        result = mod - result;
+    }
+    return result;
+}
+
+bool operator==(const BigInt& left, const BigInt& right) noexcept {
+    return left._negative == right._negative && left._magnitude == right._magnitude;
+}
+
+bool operator!=(const BigInt& left, const BigInt& right) noexcept {
+    return !(left == right);
+}
+
+bool operator<(const BigInt& left, const BigInt& right) noexcept {
+    if (left._negative != right._negative) {
+        return left._negative;
+    }
+    return left._negative ? right._magnitude < left._magnitude : left._magnitude < right._magnitude;
+}
+
+bool operator>(const BigInt& left, const BigInt& right) noexcept {
+    return right < left;
+}
+
+bool operator<=(const BigInt& left, const BigInt& right) noexcept {
+    return !(right < left);
+}
+
+bool operator>=(const BigInt& left, const BigInt& right) noexcept {
+    return !(left < right);
+}
+
+std::string to_string(const BigInt& num) {
+    return num._negative ? "-" + to_string(num._magnitude) : to_string(num._magnitude);
+}
+
+void BigInt::_normalize() noexcept {
+    if (_magnitude == 0) {
+        _negative = false;
+    }
+}
+
+std::tuple<BigNum, BigInt, BigInt> extendedGcd(const BigNum& a, const BigNum& b) {
+    /// Invariants: a * x + b * y = r and a * next_x + b * next_y = next_r
+    BigNum r = a;
+    BigNum next_r = b;
+    BigInt x = 1;
+    BigInt next_x = 0;
+    BigInt y = 0;
+    BigInt next_y = 1;
+
+    while (next_r != 0) {
+        auto [quotient, remainder] = extract(r, next_r);
+        const BigInt signed_quotient(std::move(quotient));
+
+        r = std::move(next_r);
+        next_r = std::move(remainder);
+        x = std::exchange(next_x, x - signed_quotient * next_x);
+        y = std::exchange(next_y, y - signed_quotient * next_y);
+    }
+    return {std::move(r), std::move(x), std::move(y)};
+}
+
+} // namespace lab
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "BigNum.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+namespace lab {
+
+/**
+ * @brief Signed big integer kept as sign and BigNum magnitude,
+ *        for algorithms with negative intermediate values
+ * @note Zero is never negative
+ */
+class BigInt
+{
+public:
+    BigInt() = default;
+
+    BigInt(int64_t value);
+
+    explicit BigInt(BigNum magnitude, bool negative = false);
+
+    /**
+     * @brief Decimal number with optional leading '-'
+     */
+    explicit BigInt(std::string_view num_str);
+
+    const BigNum& magnitude() const noexcept;
+
+    bool isNegative() const noexcept;
+
+    /**
+     * @return -1, 0 or 1
+     */
+    int sign() const noexcept;
+
+    BigInt operator-() const;
+
+    BigInt& operator+=(const BigInt& right);
+    BigInt& operator-=(const BigInt& right);
+    BigInt& operator*=(const BigInt& right);
+    BigInt& operator/=(const BigInt& right);
+    BigInt& operator%=(const BigInt& right);
+
+    friend BigInt operator+(BigInt left, const BigInt& right);
+    friend BigInt operator-(BigInt left, const BigInt& right);
+    friend BigInt operator*(const BigInt& left, const BigInt& right);
+
+    /**
+     * @brief Division rounding towards zero, remainder takes sign of left as for built-in integers
+     */
+    friend BigInt operator/(const BigInt& left, const BigInt& right);
+    friend BigInt operator%(const BigInt& left, const BigInt& right);
+
+    /**
+     * @return Quotient rounded towards zero and remainder with sign of left
+     * @throw std::invalid_argument if right is zero
+     */
+    friend std::pair<BigInt, BigInt> divideTruncated(const BigInt& left, const BigInt& right);
+
+    /**
+     * @return Quotient rounded towards minus infinity and remainder with sign of right
+     * @throw std::invalid_argument if right is zero
+     */
+    friend std::pair<BigInt, BigInt> divideFloored(const BigInt& left, const BigInt& right);
+
+    /**
+     * @return num mod @a mod in range [0, mod)
+     */
+    friend BigNum residue(const BigInt& num, const BigNum& mod);
+
+    friend bool operator==(const BigInt& left, const BigInt& right) noexcept;
+    friend bool operator!=(const BigInt& left, const BigInt& right) noexcept;
+    friend bool operator<(const BigInt& left, const BigInt& right) noexcept;
+    friend bool operator>(const BigInt& left, const BigInt& right) noexcept;
+    friend bool operator<=(const BigInt& left, const BigInt& right) noexcept;
+    friend bool operator>=(const BigInt& left, const BigInt& right) noexcept;
+
+    friend std::string to_string(const BigInt& num);
+
+private:
+    /**
+     * @brief Clears sign of zero
+     */
+    void _normalize() noexcept;
+
+    BigNum _magnitude = 0_bn;
+    bool _negative = false;
+};
+
+/**
+ * @return gcd(a, b) and Bezout coefficients x, y such that a * x + b * y = gcd(a, b)
+ */
+std::tuple<BigNum, BigInt, BigInt> extendedGcd(const BigNum& a, const BigNum& b);
+
+template<typename OStream>
+OStream& operator<<(OStream& os, const BigInt& num)
+{
+    os << to_string(num);
+    return os;
+}
+
+} // namespace lab
@@ -1,8 +1,13 @@
 #include <BigNum.hpp>
+#include <BigInt.hpp>
+#include <PackedBigNum.hpp>
+#include <Modulus.hpp>
 
+#include <array>
 #include <cassert>
 #include <iterator>
-#include <map>
+#include <limits>
+#include <unordered_map>
 
 namespace lab {
 
@@ -11,35 +16,36 @@ namespace {
  * @brief Points to the max value BigNum array's cell can hold,
  *        same as basis in linear representation
  */
-constexpr int NUM_BASE = 1000000000;
+constexpr int NUM_BASE = detail::CELL_BASE;
 
 /**
  * @brief Points to number of digits in (NUM_BASE-1)
  */
-constexpr char SECTION_DIGITS = 9;
+constexpr char SECTION_DIGITS = detail::CELL_DIGITS;
 
-} // <anonymous> namespace
+/**
+ * @brief Largest shift done by one pass over cells, 2^29 is below NUM_BASE
+ */
+constexpr std::size_t SHIFT_CHUNK = 29;
 
 /**
- * @brief Returns 10^power
+ * @brief 2^9 divides NUM_BASE, so the lowest cell holds this many lowest bits of number
  */
-long long powTen(int power)
-{
-    int value = 1;
-    for (int i = 1; i <= power; ++i) {
-        value *= 10;
-    }
-    return value;
-}
+constexpr std::size_t CELL_LOW_BITS = 9;
+
+} // <anonymous> namespace
+
 BigNum::BigNum(std::string_view num_str) {
-    for (int i = num_str.size() - 1; i >= 0; i -= SECTION_DIGITS) {
-        int pos = 0;
-        long long value = 0;
-        while ((pos != SECTION_DIGITS) && (i-pos >= 0)) {
-            value = value + powTen(pos)*(num_str[i-pos] - '0');
-            ++pos;
+    /// Cells are decimal, so every chunk of SECTION_DIGITS characters is one cell
+    _digits.reserve(num_str.size() / SECTION_DIGITS + 1);
+    for (std::size_t end = num_str.size(); end > 0;) {
+        const std::size_t begin = end > static_cast<std::size_t>(SECTION_DIGITS) ? end - SECTION_DIGITS : 0;
+        int64_t value = 0;
+        for (std::size_t pos = begin; pos < end; ++pos) {
+            value = value * 10 + (num_str[pos] - '0');
         }
         _digits.push_back(value);
+        end = begin;
     }
     while (!_digits.empty() && _digits.back() == 0) {
         _digits.pop_back();
@@ -49,32 +55,16 @@ BigNum::BigNum(std::string_view num_str) {
     }
 }
 
-std::string to_string(const BigNum &num)
-{
-    bool is_empty = true;
-    for (auto &pos : num._digits) {
-        if (pos != 0) {
-            is_empty = false;
-        }
-    }
-    if (is_empty) {
-        return "0";
-    }
-    std::string result;
-    int leading_zeros = 0;
-
-    for (int curr_pos = 0; curr_pos < num._digits.size(); ++curr_pos) {
-        std::string temp = std::to_string(num._digits[curr_pos]);
-        std::string offset;
-        leading_zeros = 0;
-        while (temp.size() + offset.size() != SECTION_DIGITS) {
-            offset += '0';
-            ++leading_zeros;
-        }
-        result = offset + temp + result;
-    }
+BigNum::BigNum(uint64_t value) {
+    do {
+        _digits.push_back(static_cast<int64_t>(value % NUM_BASE));
+        value /= NUM_BASE;
+    } while (value != 0);
+}
 
-    result.erase(0, leading_zeros);
+std::string to_string(const BigNum& num) {
+    std::string result(maxChars(num), '\0');
+    result.resize(static_cast<std::size_t>(toChars(result.data(), result.data() + result.size(), num) - result.data()));
     return result;
 }
 
@@ -84,107 +74,254 @@ const BigNum& BigNum::inf() {
     return _inf;
 }
 
-bool operator<(const BigNum& left, const BigNum& right) noexcept {
-    if (left._digits.size() < right._digits.size()) {
-        return true;
-    }
-
-    if (left._digits.size() > right._digits.size()) {
-        return false;
+int compare(const BigNum& left, const BigNum& right) noexcept {
+    if (left._digits.size() != right._digits.size()) {
+        return left._digits.size() < right._digits.size() ? -1 : 1;
     }
 
-    for (int curr_pos = left._digits.size() - 1; curr_pos >= 0; --curr_pos) {
-        if (left._digits[curr_pos] < right._digits[curr_pos]) {
-            return true;
-        }
-
-        if (left._digits[curr_pos] > right._digits[curr_pos]) {
-            return false;
+    for (auto curr_pos = left._digits.size(); curr_pos-- > 0;) {
+        if (left._digits[curr_pos] != right._digits[curr_pos]) {
+            return left._digits[curr_pos] < right._digits[curr_pos] ? -1 : 1;
         }
     }
 
-    return false;
+    return 0;
+}
+
+bool operator<(const BigNum& left, const BigNum& right) noexcept {
+    return compare(left, right) < 0;
 }
 
-bool operator>(const BigNum& left, const BigNum& right)noexcept {
-    return (right < left);
+bool operator>(const BigNum& left, const BigNum& right) noexcept {
+    return compare(left, right) > 0;
 }
 
 bool operator<=(const BigNum& left, const BigNum& right) noexcept {
-    return !(right < left);
+    return compare(left, right) <= 0;
 }
 
 bool operator>=(const BigNum& left, const BigNum& right) noexcept {
-    return !(left < right);
+    return compare(left, right) >= 0;
 }
 
 bool operator==(const BigNum& left, const BigNum& right) noexcept {
-    return ((!(right < left)) && (!(left < right)));
+    /// Cells are trimmed, so equal numbers have equal cells and sizes are checked first
+    return left._digits == right._digits;
 }
 
 bool operator!=(const BigNum& left, const BigNum& right) noexcept {
     return !(left == right);
 }
 
-BigNum operator+(const BigNum &left, const BigNum &right) {
-    if (right._digits.size() > left._digits.size()) {
-        auto result = right;
-        int addition = 0;
-        for (int curr_pos = 0; curr_pos < left._digits.size(); ++curr_pos) {
-            result._digits[curr_pos] += left._digits[curr_pos] + addition;
-            addition = result._digits[curr_pos] / NUM_BASE;
-            result._digits[curr_pos] = result._digits[curr_pos] % NUM_BASE;
+std::size_t hash(const BigNum& num) noexcept {
+    return detail::hashCells(num._digits.data(), num._digits.size());
+}
+
+std::size_t hashLowCell(const BigNum& num) noexcept {
+    return static_cast<std::size_t>(detail::mixBits(num._digits.empty() ? 0 : static_cast<uint64_t>(num._digits[0])));
+}
+
+BigNum& BigNum::operator+=(const BigNum& right) {
+    if (_digits.size() < right._digits.size()) {
+        _digits.resize(right._digits.size(), 0);
+    }
+
+    int64_t addition = 0;
+    for (std::size_t curr_pos = 0; curr_pos < _digits.size(); ++curr_pos) {
+        if (curr_pos >= right._digits.size() && addition == 0) {
+            break;
         }
+        _digits[curr_pos] += addition + (curr_pos < right._digits.size() ? right._digits[curr_pos] : 0);
+        addition = _digits[curr_pos] >= NUM_BASE;
         if (addition != 0) {
-            result._digits[left._digits.size()-1] += addition;
+            _digits[curr_pos] -= NUM_BASE;
         }
+    }
+    if (addition != 0) {
+        _digits.push_back(addition);
+    }
+    return *this;
+}
 
-        return result;
-    } else {
-        auto result = left;
-        int addition = 0;
-
-        for (int curr_pos = 0; curr_pos < right._digits.size(); ++curr_pos) {
-            long long temp = static_cast<long long>(result._digits[curr_pos])
-                    + static_cast<long long>(right._digits[curr_pos]) + addition;
-            result._digits[curr_pos] = temp % NUM_BASE;
-            addition = temp / NUM_BASE;
-            result._digits[curr_pos] = result._digits[curr_pos] % NUM_BASE;
+BigNum& BigNum::operator-=(const BigNum& right) {
+    int64_t borrow = 0;
+    for (std::size_t curr_pos = 0; curr_pos < _digits.size(); ++curr_pos) {
+        if (curr_pos >= right._digits.size() && borrow == 0) {
+            break;
         }
-        if (addition != 0) {
-            if (left._digits.size() == right._digits.size()) {
-                result._digits.push_back(addition);
-            } else {
-                result._digits[right._digits.size()-1] += addition;
-            }
+        _digits[curr_pos] -= borrow + (curr_pos < right._digits.size() ? right._digits[curr_pos] : 0);
+        borrow = _digits[curr_pos] < 0;
+        if (borrow != 0) {
+            _digits[curr_pos] += NUM_BASE;
         }
+    }
+    _trim();
+    return *this;
+}
 
-        return result;
+BigNum& BigNum::operator*=(const BigNum& right) {
+    *this = *this * right;
+    return *this;
+}
+
+BigNum& BigNum::operator/=(const BigNum& right) {
+    *this = std::move(extract(*this, right).first);
+    return *this;
+}
+
+BigNum& BigNum::operator%=(const BigNum& right) {
+    *this = std::move(extract(*this, right).second);
+    return *this;
+}
+
+BigNum& BigNum::operator+=(uint64_t right) {
+    if (_digits.empty()) {
+        _digits.push_back(0);
     }
+    uint64_t addition = right;
+    for (std::size_t curr_pos = 0; addition != 0; ++curr_pos) {
+        if (curr_pos == _digits.size()) {
+            _digits.push_back(0);
+        }
+        const uint64_t temp = static_cast<uint64_t>(_digits[curr_pos]) + addition % NUM_BASE;
+        _digits[curr_pos] = static_cast<int64_t>(temp % NUM_BASE);
+        addition = addition / NUM_BASE + temp / NUM_BASE;
+    }
+    return *this;
+}
+
+BigNum& BigNum::operator-=(uint64_t right) {
+    uint64_t subtraction = right;
+    for (std::size_t curr_pos = 0; subtraction != 0 && curr_pos < _digits.size(); ++curr_pos) {
+        _digits[curr_pos] -= static_cast<int64_t>(subtraction % NUM_BASE);
+        subtraction /= NUM_BASE;
+        if (_digits[curr_pos] < 0) {
+            _digits[curr_pos] += NUM_BASE;
+            ++subtraction;
+        }
+    }
+    _trim();
+    return *this;
+}
+
+void BigNum::swap(BigNum& that) noexcept {
+    _digits.swap(that._digits);
+}
+
+void swap(BigNum& left, BigNum& right) noexcept {
+    left.swap(right);
+}
+
+BigNum operator+(const BigNum& left, const BigNum& right) {
+    /// Copying the longer operand saves growing the result
+    const bool is_left_longer = left._digits.size() >= right._digits.size();
+    BigNum result = is_left_longer ? left : right;
+    result += is_left_longer ? right : left;
+    return result;
+}
+
+BigNum operator+(BigNum&& left, const BigNum& right) {
+    left += right;
+    return std::move(left);
 }
 
-BigNum operator-(const BigNum &left, const BigNum &right) {
+BigNum operator+(const BigNum& left, BigNum&& right) {
+    right += left;
+    return std::move(right);
+}
+
+BigNum operator+(BigNum&& left, BigNum&& right) {
+    left += right;
+    return std::move(left);
+}
+
+BigNum operator-(const BigNum& left, const BigNum& right) {
     BigNum result = left;
-    for (int curr_pos = 0; curr_pos < right._digits.size(); ++curr_pos) {
-        if (result._digits[curr_pos] < right._digits[curr_pos]) {
-            result._digits[curr_pos] = result._digits[curr_pos] - right._digits[curr_pos] + NUM_BASE;
-            result._digits[curr_pos + 1] -= 1;
-        } else {
-            result._digits[curr_pos] = result._digits[curr_pos] - right._digits[curr_pos];
+    result -= right;
+    return result;
+}
+
+BigNum operator-(BigNum&& left, const BigNum& right) {
+    left -= right;
+    return std::move(left);
+}
+
+BigNum operator+(const BigNum& left, uint64_t right) {
+    BigNum result = left;
+    result += right;
+    return result;
+}
+
+BigNum operator+(BigNum&& left, uint64_t right) {
+    left += right;
+    return std::move(left);
+}
+
+BigNum operator-(const BigNum& left, uint64_t right) {
+    BigNum result = left;
+    result -= right;
+    return result;
+}
+
+BigNum operator-(BigNum&& left, uint64_t right) {
+    left -= right;
+    return std::move(left);
+}
+
+uint64_t operator%(const BigNum& left, uint64_t right) {
+    if (right == 0) {
+        throw std::invalid_argument("Second num must not be 0");
+    }
+    uint64_t remainder = 0;
+    if (right <= std::numeric_limits<uint64_t>::max() / NUM_BASE) {
+        for (auto cell = left._digits.rbegin(); cell != left._digits.rend(); ++cell) {
+            remainder = (remainder * NUM_BASE + static_cast<uint64_t>(*cell)) % right;
+        }
+    } else {
+        for (auto cell = left._digits.rbegin(); cell != left._digits.rend(); ++cell) {
+            remainder = static_cast<uint64_t>((static_cast<unsigned __int128>(remainder) * NUM_BASE + *cell) % right);
         }
     }
-    if (left._digits.size() > right._digits.size()) {
-        if (result._digits[right._digits.size()] < 0) {
-            result._digits[right._digits.size()] += NUM_BASE;
-            result._digits[right._digits.size() + 1] -= 1;
+    return remainder;
+}
+
+bool operator==(const BigNum& left, uint64_t right) noexcept {
+    std::size_t curr_pos = 0;
+    for (; curr_pos < left._digits.size(); ++curr_pos) {
+        if (static_cast<uint64_t>(left._digits[curr_pos]) != right % NUM_BASE) {
+            return false;
         }
+        right /= NUM_BASE;
     }
-    while (!result._digits.empty() && (result._digits.back() == 0)) {
-       result. _digits.pop_back();
+    return right == 0;
+}
+
+bool operator!=(const BigNum& left, uint64_t right) noexcept {
+    return !(left == right);
+}
+
+void BigNum::_trim() {
+    while (_digits.size() > 1 && _digits.back() == 0) {
+        _digits.pop_back();
+    }
+    if (_digits.empty()) {
+        _digits.push_back(0);
     }
-    if (result._digits.empty()) {
-        result._digits.push_back(0);
+}
+
+BigNum BigNum::_highCells(std::size_t from) const {
+    BigNum result;
+    if (from < _digits.size()) {
+        result._digits.assign(_digits.begin() + from, _digits.end());
     }
+    result._trim();
+    return result;
+}
+
+BigNum BigNum::_lowCells(std::size_t count) const {
+    BigNum result;
+    result._digits.assign(_digits.begin(), _digits.begin() + std::min(count, _digits.size()));
+    result._trim();
     return result;
 }
 
@@ -226,183 +363,211 @@ BigNum operator*(const BigNum &left, int right) {
     } else {
         result._digits.push_back(addition);
     }
-    while (!result._digits.empty() && result._digits.back() == 0)
-        result._digits.pop_back();
+    result._trim();
     return result;
 }
 
-/**
- * @brief Compares vector of digits with operator <
- * @param step points to the number of digits from beginning of left var to compare
- */
-bool isLowerDigits(const std::vector<char> &left, const std::vector<char> &right, int step) {
-    if ((step > right.size()) && (step <= left.size())) return false;
-    if ((step < right.size()) || (left.size() < right.size())) return true;
-    if (step > left.size()) return true;
-    for (int i = right.size() - 1; i >= 0; --i) {
-        if (left[left.size() + i - step] < right[i]) return true;
-        if (left[left.size() + i - step] > right[i]) return false;
+namespace {
+    /**
+     * @brief Divides cells by a number smaller than NUM_BASE in place
+     * @return Remainder of division
+     */
+    template <typename Cells>
+    int64_t divideBySmall(Cells& cells, int64_t divisor) {
+        int64_t remainder = 0;
+        for (auto cell = cells.rbegin(); cell != cells.rend(); ++cell) {
+            const int64_t temp = remainder * NUM_BASE + *cell;
+            *cell = temp / divisor;
+            remainder = temp % divisor;
+        }
+        return remainder;
     }
-    return false;
+
+    /**
+     * @brief Multiplies cells by a number smaller than NUM_BASE in place, may grow by one cell
+     */
+    template <typename Cells>
+    void multiplyBySmall(Cells& cells, int64_t factor) {
+        int64_t addition = 0;
+        for (auto& cell : cells) {
+            const int64_t temp = cell * factor + addition;
+            cell = temp % NUM_BASE;
+            addition = temp / NUM_BASE;
+        }
+        if (addition != 0) {
+            cells.push_back(addition);
+        }
+    }
+} // <anonymous> namespace
+
+BigNum& BigNum::operator<<=(std::size_t shift) {
+    if (*this == 0) {
+        return *this;
+    }
+    for (; shift != 0; shift -= std::min(shift, SHIFT_CHUNK)) {
+        multiplyBySmall(_digits, int64_t{1} << std::min(shift, SHIFT_CHUNK));
+    }
+    return *this;
 }
 
-bool isLowerDigits(const std::vector<char> &left, const std::vector<char> &right, int step);
+BigNum& BigNum::operator>>=(std::size_t shift) {
+    for (; shift != 0 && *this != 0; shift -= std::min(shift, SHIFT_CHUNK)) {
+        divideBySmall(_digits, int64_t{1} << std::min(shift, SHIFT_CHUNK));
+        _trim();
+    }
+    return *this;
+}
 
-auto addDigits(const std::vector <char> &lhs, const std::vector <char> &rhs) {
+BigNum operator<<(BigNum num, std::size_t shift) {
+    num <<= shift;
+    return num;
+}
 
-    constexpr auto BASE = 10;
-    std::vector <char> result;
+BigNum operator>>(BigNum num, std::size_t shift) {
+    num >>= shift;
+    return num;
+}
 
+bool isOdd(const BigNum& num) noexcept {
+    return !num._digits.empty() && num._digits[0] % 2 == 1;
+}
 
-    if (isLowerDigits(lhs, rhs, 0)) {
-        result = rhs;
-        int addition{};
-        for (std::size_t i = 0; i < rhs.size(); ++i) {
-            result[i] += (i >= lhs.size()) ? addition : lhs[i] + addition;
-            addition = result[i] / BASE;
-            result[i] %= BASE;
-        }
-    } else {
-        result = lhs;
-        int addition{};
-        for (std::size_t i = 0; i < rhs.size(); ++i) {
-            result[i] += (i >= rhs.size()) ? addition : rhs[i] + addition;
-            addition = result[i] / BASE;
-            result[i] %= BASE;
-        }
-    }
-    return result;
+bool isEven(const BigNum& num) noexcept {
+    return !isOdd(num);
 }
 
-/**
- * @brief Multiplies vector of digits and int
- */
-std::vector<char> multiplyDigits(std::vector<char> &num1, int num2) {
-    std::vector<char> result = num1;
-    int addition = 0;
-    for (int curr_pos = 0; curr_pos < result.size(); ++curr_pos) {
-        long long temp = result[curr_pos] * num2 + addition;
-        result[curr_pos] = temp % 10;
-        addition = temp / 10;
+uint64_t lowBits(const BigNum& num, std::size_t count) {
+    if (count > 64) {
+        throw std::invalid_argument("lowBits returns at most 64 bits");
     }
-    if (addition != 0) {
-        result.push_back(addition);
+    if (count <= CELL_LOW_BITS) {
+        return num._digits.empty() ? 0 : static_cast<uint64_t>(num._digits[0]) % (uint64_t{1} << count);
     }
-    return result;
+    if (count < 64) {
+        return num % (uint64_t{1} << count);
+    }
+    return toWords(num)[0];
 }
 
-/**
- * @brief Returns power of basis to make two numbers almost equal
- * @param fnum number to reach
- * @param snum number to multiply
- * @return Maximum power of basis to reach bottom border of fnum
- */
-int getMaxPow(std::vector<char> &fnum, std::vector<char> &snum)
-{
-    if (snum.size() > fnum.size()) {
-        return -1;
+std::size_t bitLength(const BigNum& num) {
+    thread_local std::vector<uint64_t> words;
+    toWords(words, num);
+    std::size_t result = (words.size() - 1) * 64;
+    for (auto top = words.back(); top != 0; top >>= 1) {
+        result += 1;
     }
-    int current_pow = fnum.size() - snum.size();
-    for (int i = snum.size() - 1; i >= 0; --i) {
-        if (snum[i] > fnum[i + current_pow]) {
-            return current_pow - 1;
-        }
-        if (snum[i] < fnum[i + current_pow]) {
-            return current_pow;
-        }
+    return result;
+}
+
+bool testBit(const BigNum& num, std::size_t bit) {
+    if (bit < CELL_LOW_BITS) {
+        return (lowBits(num, CELL_LOW_BITS) >> bit) & 1;
     }
-    return current_pow;
+    return isOdd(num >> bit);
 }
 
-/// TODO fix +=10 after changing basis
-/**
- * @brief Subtracts two numbers, where second one is multiplied on basis with given power.
- *        Result stores in first parameter
- * @param curr_pow power of basis
- */
-void subtractPow(std::vector<char> &fnum, std::vector<char> &snum, int curr_pow)
-{
-    for (int i = 0; i < snum.size(); ++i) {
-        if (fnum[i + curr_pow] < snum[i]) {
-            fnum[i + curr_pow] += 10;
-            fnum[i + curr_pow + 1] -= 1;
+std::size_t popcount(const BigNum& num) {
+    thread_local std::vector<uint64_t> words;
+    toWords(words, num);
+    std::size_t result = 0;
+    for (auto word : words) {
+        for (; word != 0; word &= word - 1) {
+            result += 1;
         }
-        fnum[i + curr_pow] -= snum[i];
     }
+    return result;
 }
 
-/**
- * @brief Compares with operator<= two numbers, where second one is multiplied on basis with given power
- * @param curr_pow power of basis
- */
-bool lessNumPow(std::vector<char> &fnum, std::vector<char> &snum, int curr_pow)
-{
-    if (curr_pow + snum.size() < fnum.size()) {
-        return true;
-    }
-    for (int i = snum.size() - 1; i >= 0; --i) {
-        if (fnum[i + curr_pow] < snum[i]) {
-            return false;
-        }
-        if (fnum[i + curr_pow] > snum[i]) {
-            return true;
-        }
+BigNum operator&(const BigNum& left, const BigNum& right) {
+    auto words = toWords(left);
+    const auto right_words = toWords(right);
+    words.resize(std::min(words.size(), right_words.size()));
+    for (std::size_t i = 0; i < words.size(); i += 1) {
+        words[i] &= right_words[i];
     }
-    return true;
+    return fromWords(words);
 }
 
 std::pair<BigNum, BigNum> extract(const BigNum &left, const BigNum &right) {
-    if (right == 0_bn) {
+    if (right == 0) {
         throw std::invalid_argument("Second num must not be 0");
     }
     if (left < right) {
         return std::pair<BigNum, BigNum>(0_bn, left);
     }
 
-    std::vector<char> fnum = toOneDigit(left);
-    std::vector<char> snum = toOneDigit(right);
-    std::vector<char> current = snum;
-    std::vector<char> result;
-    int curr_pow = getMaxPow(fnum, snum);
-    int hight_rank = 1;
-    while (true) {
-        while (lessNumPow(fnum, current, curr_pow)) {
-            ++hight_rank;
-            current = multiplyDigits(snum, hight_rank);
-        }
-        current = multiplyDigits(snum, hight_rank - 1);
-        subtractPow(fnum, current, curr_pow);
-        result.push_back(hight_rank-1);
-        int to_delete = current.size();
-        while (!fnum.empty() && (fnum.back() == 0) && (to_delete > 0)) {
-            fnum.pop_back();
-            --to_delete;
-        }
-        while (!fnum.empty() && (fnum.back() == 0)) {
-            fnum.pop_back();
-            --curr_pow;
-            result.push_back(0);
-        }
-        if ((fnum.size() <= curr_pow) && (curr_pow <= snum.size()) && !lessNumPow(fnum, snum, 0)) {
-            for (int i = 0; i < fnum.size(); i++) {
-                result.push_back(0);
+    BigNum quotient;
+    BigNum remainder;
+
+    if (right._digits.size() == 1) {
+        quotient._digits = left._digits;
+        remainder._digits.push_back(divideBySmall(quotient._digits, right._digits[0]));
+        quotient._trim();
+        return std::pair{std::move(quotient), std::move(remainder)};
+    }
+
+    /// Knuth's algorithm D: normalize so the top cell of divisor is at least NUM_BASE / 2,
+    /// then every estimated quotient cell is off by at most two
+    const int64_t factor = NUM_BASE / (right._digits.back() + 1);
+    auto u = left._digits;
+    auto v = right._digits;
+    multiplyBySmall(u, factor);
+    multiplyBySmall(v, factor);
+    u.resize(left._digits.size() + 1, 0);
+
+    const std::size_t n = v.size();
+    const std::size_t m = u.size() - n;
+    quotient._digits.assign(m, 0);
+
+    for (std::size_t j = m; j-- > 0;) {
+        const int64_t top = u[j + n] * NUM_BASE + u[j + n - 1];
+        int64_t q_hat = top / v[n - 1];
+        int64_t r_hat = top % v[n - 1];
+        while (q_hat >= NUM_BASE || q_hat * v[n - 2] > r_hat * NUM_BASE + u[j + n - 2]) {
+            --q_hat;
+            r_hat += v[n - 1];
+            if (r_hat >= NUM_BASE) {
+                break;
             }
         }
-        int new_pow = getMaxPow(fnum, snum);
-        if (new_pow == -1) {
-            break;
+
+        /// u[j..j+n] -= q_hat * v
+        int64_t addition = 0;
+        int64_t borrow = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const int64_t product = q_hat * v[i] + addition;
+            addition = product / NUM_BASE;
+            u[i + j] -= product % NUM_BASE + borrow;
+            borrow = u[i + j] < 0;
+            if (borrow != 0) {
+                u[i + j] += NUM_BASE;
+            }
         }
-        while (curr_pow != new_pow + 1) {
-            --curr_pow;
-            result.push_back(0);
+        u[j + n] -= addition + borrow;
+
+        /// Estimation was one too big, add divisor back
+        if (u[j + n] < 0) {
+            --q_hat;
+            int64_t carry = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                u[i + j] += v[i] + carry;
+                carry = u[i + j] >= NUM_BASE;
+                if (carry != 0) {
+                    u[i + j] -= NUM_BASE;
+                }
+            }
+            u[j + n] += carry;
         }
-        --curr_pow;
-        hight_rank = 1;
-        current = snum;
+        quotient._digits[j] = q_hat;
     }
 
-    std::reverse(result.begin(), result.end());
-    return std::pair{toBigNum(result), toBigNum(fnum)};
+    u.resize(n);
+    divideBySmall(u, factor);
+    remainder._digits = std::move(u);
+
+    quotient._trim();
+    remainder._trim();
+    return std::pair{std::move(quotient), std::move(remainder)};
 }
 
 void modify(BigNum& num, const BigNum& mod) {
@@ -480,23 +645,19 @@ namespace {
     };
 
     /**
-     *  @brief Returns nearest number bigger than n that is degree of two
-    */
-    inline unsigned upperLog2(const unsigned n) {
-        return std::pow(2, static_cast<int>(std::log2(n)) + 1);
-    }
-
-    std::vector<int64_t> naiveMultiplication(const ArrayView<int64_t>& lhs,
-                                             const ArrayView<int64_t>& rhs) {
-        std::vector<int64_t> result(lhs.size() + rhs.size());
-
-        for (int i = 0; i < lhs.size(); ++i) {
-            for (int j = 0; j < rhs.size(); ++j) {
-                result[i + j] += lhs[i] * rhs[j];
+     * @brief Schoolbook multiplication, carries are propagated on every row
+     *        so cells never overflow int64_t
+     */
+    void naiveMultiplication(const ArrayView<int64_t>& lhs, const ArrayView<int64_t>& rhs, int64_t* result) {
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            int64_t addition = 0;
+            for (std::size_t j = 0; j < rhs.size(); ++j) {
+                const int64_t temp = result[i + j] + lhs[i] * rhs[j] + addition;
+                result[i + j] = temp % NUM_BASE;
+                addition = temp / NUM_BASE;
             }
+            result[i + rhs.size()] += addition;
         }
-
-        return result;
     }
 
     /**
@@ -505,85 +666,82 @@ namespace {
      */
     constexpr inline int MIN_FOR_KARATSUBA = 32;
 
+    /**
+     * @brief Adds @a num shifted by @a offset cells to @a acc, acc must be long enough
+     */
+    void addShifted(std::vector<int64_t>& acc, const std::vector<int64_t>& num, std::size_t offset) {
+        int64_t addition = 0;
+        for (std::size_t i = 0; i < num.size() || addition != 0; ++i) {
+            acc[i + offset] += addition + (i < num.size() ? num[i] : 0);
+            addition = acc[i + offset] >= NUM_BASE;
+            if (addition != 0) {
+                acc[i + offset] -= NUM_BASE;
+            }
+        }
+    }
+
+    /**
+     * @brief Subtracts @a num from @a acc, acc must be not less than num
+     */
+    void subtractFrom(std::vector<int64_t>& acc, const std::vector<int64_t>& num) {
+        int64_t borrow = 0;
+        for (std::size_t i = 0; i < num.size() || borrow != 0; ++i) {
+            acc[i] -= borrow + (i < num.size() ? num[i] : 0);
+            borrow = acc[i] < 0;
+            if (borrow != 0) {
+                acc[i] += NUM_BASE;
+            }
+        }
+    }
+
     /*
      * @brief Karatsuba's method implements fast multiplication of numbers [AB] and [CD] like
      *        like (A * 10 + B) * (C * 10 + D) = AC * 100 + BD + ((A + B) * (C + D) - AC - BD) * 10
+     * @note Both operands must have the same size
      */
-
     std::vector<int64_t> karatsuba(const ArrayView<int64_t>& lhs, const ArrayView<int64_t>& rhs) {
         if (lhs.size() <= MIN_FOR_KARATSUBA) {
-            return naiveMultiplication(lhs, rhs);
+            std::vector<int64_t> result(lhs.size() + rhs.size(), 0);
+            naiveMultiplication(lhs, rhs, result.data());
+            return result;
         }
 
         const auto length = lhs.size();
-        std::vector<int64_t> result(length * 2);
+        const auto half = length / 2;
 
-        ArrayView<int64_t> lhsL(lhs.begin() + length / 2, lhs.end());
-        ArrayView<int64_t> rhsL(rhs.begin() + length / 2, rhs.end());
-        ArrayView<int64_t> lhsR(lhs.begin(), lhs.begin() + length / 2);
-        ArrayView<int64_t> rhsR(rhs.begin(), rhs.begin() + length / 2);
+        ArrayView<int64_t> lhsL(lhs.begin() + half, lhs.end());
+        ArrayView<int64_t> rhsL(rhs.begin() + half, rhs.end());
+        ArrayView<int64_t> lhsR(lhs.begin(), lhs.begin() + half);
+        ArrayView<int64_t> rhsR(rhs.begin(), rhs.begin() + half);
 
         const auto c1 = karatsuba(lhsL, rhsL);
         const auto c2 = karatsuba(lhsR, rhsR);
 
-        std::vector<int64_t> lhsLR(length / 2);
-        std::vector<int64_t> rhsLR(length / 2);
-
-        for (auto i = 0; i < length / 2; ++i) {
-            lhsLR[i] = lhsL[i] + lhsR[i];
-            rhsLR[i] = rhsL[i] + rhsR[i];
-        }
+        std::vector<int64_t> lhsLR(lhsL.begin(), lhsL.end());
+        std::vector<int64_t> rhsLR(rhsL.begin(), rhsL.end());
+        lhsLR.push_back(0);
+        rhsLR.push_back(0);
+        addShifted(lhsLR, std::vector<int64_t>(lhsR.begin(), lhsR.end()), 0);
+        addShifted(rhsLR, std::vector<int64_t>(rhsR.begin(), rhsR.end()), 0);
 
         auto c3 = karatsuba(
             ArrayView<int64_t>{lhsLR.begin(), lhsLR.end()},
             ArrayView<int64_t>{rhsLR.begin(), rhsLR.end()}
         );
-
-        for (auto i = 0; i < length; ++i){
-            c3[i] -= c2[i] + c1[i];
-        }
-
-        for (auto i = 0; i < length; ++i) {
-            result[i] = c2[i];
-        }
-
-        for (auto i = length; i < length * 2; ++i) {
-            result[i] = c1[i - length];
+        subtractFrom(c3, c1);
+        subtractFrom(c3, c2);
+        while (!c3.empty() && c3.back() == 0) {
+            c3.pop_back();
         }
 
-        for (auto i = length / 2; i < length + length / 2; ++i) {
-            result[i] += c3[i - length / 2];
-        }
+        std::vector<int64_t> result(length * 2 + 1);
+        addShifted(result, c2, 0);
+        addShifted(result, c1, half * 2);
+        addShifted(result, c3, half);
 
         return result;
     }
 
-    /*
-     * @brief Normalizing number ceils to NUM_BASE
-     */
-    inline void finalize(std::vector<int64_t>& num) {
-        for (auto i = 0; i < num.size(); ++i) {
-            if (i != num.size() - 1) {
-                num[i + 1] += num[i] / NUM_BASE;
-            }
-            num[i] %= NUM_BASE;
-        }
-    }
-
-    /*
-    *  @return Pair of x, y
-    *          ax + by = gcd(a, b)
-    */
-    std::pair<BigNum, BigNum> extendedEuclid(const BigNum& a, const BigNum& b, const BigNum& mod) {
-
-        if (b == BigNum("0")) {
-            return std::pair(1_bn, 0_bn);
-        }
-        const auto& [int_part, remainder] = extract(a, b);
-        const auto& [x, y] = extendedEuclid(b, remainder, mod);
-        return std::pair(y, subtract(x, (int_part * y) % mod, mod));
-    }
-
     bool isPrime(const BigNum& num) {
         if (num <= 1_bn) {
             return false;
@@ -592,12 +750,12 @@ namespace {
             return true;
         }
 
-        if (num % 2_bn == 0_bn || num % 3_bn == 0_bn) {
+        if (isEven(num) || num % 3 == 0) {
             return false;
         }
 
-        for (auto i = 5_bn; i * i <= num; i = i + 6_bn) {
-            if (num % i == 0_bn || num % (i + 2_bn) == 0_bn) {
+        for (auto i = 5_bn; i * i <= num; i += 6) {
+            if (num % i == 0 || num % (i + 2) == 0) {
                 return false;
             }
         }
@@ -605,38 +763,62 @@ namespace {
     }
 
     BigNum pow(const BigNum& num, const BigNum& degree, const BigNum& mod) {
-        if (degree == 0_bn) {
-            return 1_bn;
-        }
-
-        auto result = pow(num, extract(degree, 2_bn).first, mod) % mod;
-        result = (result * result) % mod;
-        return degree % 2_bn == 0_bn ? result : (result * num) % mod;
+        return pow(num, degree, BarrettReducer(mod));
     }
 }
 
 BigNum operator*(const BigNum& lhs, const BigNum& rhs) {
+    BigNum result;
+    if (std::min(lhs._digits.size(), rhs._digits.size()) <= MIN_FOR_KARATSUBA) {
+        multiplyInto(result, lhs, rhs);
+        return result;
+    }
+
     auto lhsTemp = lhs._digits;
     auto rhsTemp = rhs._digits;
-    const int maxSize = std::max(lhsTemp.size(), rhsTemp.size());
+    const auto maxSize = std::max(lhsTemp.size(), rhsTemp.size());
+    lhsTemp.resize(maxSize);
+    rhsTemp.resize(maxSize);
 
-    lhsTemp.resize(upperLog2(maxSize));
-    rhsTemp.resize(upperLog2(maxSize));
-
-    auto nums = karatsuba(
+    const auto product = karatsuba(
         ArrayView<int64_t>{lhsTemp.begin(), lhsTemp.end()},
         ArrayView<int64_t>{rhsTemp.begin(), rhsTemp.end()}
     );
+    result._digits.assign(product.begin(), product.end());
+    result._trim();
+    return result;
+}
 
-    finalize(nums);
+void addInto(BigNum& out, const BigNum& left, const BigNum& right) {
+    if (&out == &right) {
+        out += left;
+        return;
+    }
+    out = left;
+    out += right;
+}
 
-    while (!nums.empty() && nums.back() == 0) {
-        nums.pop_back();
+void subtractInto(BigNum& out, const BigNum& left, const BigNum& right) {
+    if (&out == &right) {
+        out = left - right;
+        return;
     }
+    out = left;
+    out -= right;
+}
 
-    BigNum result;
-    result._digits.assign(nums.begin(), nums.end());
-    return result;
+void multiplyInto(BigNum& out, const BigNum& left, const BigNum& right) {
+    if (&out == &left || &out == &right
+        || std::min(left._digits.size(), right._digits.size()) > MIN_FOR_KARATSUBA) {
+        out = left * right;
+        return;
+    }
+
+    out._digits.assign(left._digits.size() + right._digits.size(), 0);
+    naiveMultiplication(ArrayView<int64_t>{left._digits.begin(), left._digits.end()},
+                        ArrayView<int64_t>{right._digits.begin(), right._digits.end()},
+                        out._digits.data());
+    out._trim();
 }
 
 BigNum multiply(const BigNum& lhs, const BigNum& rhs, const BigNum& mod) {
@@ -647,27 +829,23 @@ BigNum inverted(const BigNum& num,
                 const BigNum& mod,
                 const BigNum::InversionPolicy policy = BigNum::InversionPolicy::Euclid) {
     if (policy == BigNum::InversionPolicy::Euclid) {
-        if (gcd(num, mod) != 1_bn) {
+        /// Coefficients are signed, so no reduction is needed between steps
+        const auto [divisor, x, y] = extendedGcd(num % mod, mod);
+        if (divisor != 1) {
             throw std::invalid_argument("Nums must be coprime.");
         }
-
-        auto inverted = extendedEuclid(num, mod, mod).first;
-        while (!inverted._digits.empty() && inverted._digits.back() == 0) {
-            inverted._digits.pop_back();
-        }
-
-        return inverted;
+        return residue(x, mod);
     } else {
 #ifdef ENABLE_IS_PRIME_CHECK
         if (!isPrime(mod)) {
             throw std::invalid_argument("Mod must be prime.");
         }
 #endif
-        if (gcd(num, mod) != 1_bn) {
+        if (gcd(num, mod) != 1) {
             throw std::invalid_argument("Nums must be coprime.");
         }
 
-        return pow (num, mod - 2_bn, mod);
+        return pow (num, mod - 2, mod);
     }
 }
 
@@ -675,70 +853,9 @@ BigNum operator/(const BigNum& left, const BigNum& right) {
     return extract(left, right).first;
 }
 
-std::optional<std::pair<BigNum, BigNum>> sqrt(const BigNum& n, const BigNum& p)
+std::optional<std::pair<BigNum, BigNum>> sqrt(const BigNum& num, const BigNum& mod)
 {
-    // NOTE: Names of variables are taken directly from Wikipedia for better understanding
-
-    /// If it doesn't satisfy Fermat's little theorem than we can't find result
-    if (pow(n, (p - 1_bn) / 2_bn, p) != 1_bn) {
-        return {};
-    }
-
-    /// Attempt to find trivial solution
-    const auto& [q, s] = [&] {
-        auto q = p - 1_bn;
-        auto s = 0_bn;
-        while (q % 2_bn == 0_bn) {
-            q = q / 2_bn;
-            s = s + 1_bn;
-        }
-
-        return std::pair{q, s};
-    }();
-
-    /// If p = 3 (mod 4) than solutions are trivial
-    if (s == 1_bn) {
-        const auto x = pow(n, (p + 1_bn) / 4_bn, p);
-        return std::pair{x, p - x};
-    }
-
-    /// Select a quadric non-residue (mod p)
-    const auto z = [&] {
-        for (auto i = 1_bn; i < p; i = i + 1_bn) {
-            if (pow(i, (p - 1_bn) / 2_bn, p) != 1_bn) {
-                return i;
-            }
-        }
-
-        return 0_bn;
-    }();
-
-    auto c = pow(z, q, p);
-    auto r = pow(n, (q + 1_bn) / 2_bn, p);
-    auto t = pow(n, q, p);
-    auto m = s;
-
-    while (t != 1_bn) {
-        const auto& [i, x] = [&] {
-            auto i = 1_bn;
-            auto x = t * t % p;
-            while (x != 1_bn) {
-                x = x * x % p;
-                i = i + 1_bn;
-            }
-
-            return std::pair(i, x);
-        }();
-        
-        const auto b = pow(c, pow(2_bn, (m - i - 1_bn), p), p);
-
-        r = (r * b) % p;
-        c = (b * b) % p;
-        t = (t * c) % p;
-        m = i;
-    }
-    
-    return std::pair{r, p - r};
+    return SqrtContext::cached(mod)->sqrt(num);
 }
 
 int countDigit(long long n) {
@@ -757,7 +874,7 @@ int length(const BigNum& num) {
 }
 
 BigNum calculateMontgomeryCoefficient(const BigNum& mod) {
-    if (mod == 5_bn) {
+    if (mod == 5) {
         return 100_bn;
     }
     std::string res(length(mod) + 1, '0');
@@ -792,77 +909,142 @@ BigNum multiplyMontgomery(const BigNum& left, const BigNum& right, const BigNum&
 BigNum powMontgomery(const BigNum& base, BigNum degree, const BigNum& mod) {
     BigNum montgomery_coefficient = calculateMontgomeryCoefficient(mod);
     BigNum mc_inverted = inverted(montgomery_coefficient, mod, BigNum::InversionPolicy::Euclid);
-    BigNum coefficient = extract(montgomery_coefficient * mc_inverted - 1_bn, mod).first;
-    std::pair<BigNum, BigNum> extraction;
+    BigNum coefficient = extract(montgomery_coefficient * mc_inverted - 1, mod).first;
     BigNum base_mf = convertToMontgomeryForm(base, mod, montgomery_coefficient);
     BigNum result = convertToMontgomeryForm(1_bn,mod,montgomery_coefficient);
     while(degree > 0_bn) {
-        extraction = extract(degree, 2_bn);
-        if(extraction.second == 1_bn) {
+        if(isOdd(degree)) {
             result = multiplyMontgomery(result, base_mf, mod, montgomery_coefficient, coefficient);
         }
-        degree = extraction.first;
+        degree >>= 1;
         base_mf = multiplyMontgomery(base_mf, base_mf, mod, montgomery_coefficient, coefficient);
     }
     result = multiply(result, mc_inverted, mod);
     return result;
 }
 
-BigNum sqrt(const BigNum& num) {
-    if (num == 1_bn) {
-        return 1_bn;
+namespace {
+
+/**
+ * @brief Moduli of square filters, their product fits into uint64_t
+ */
+constexpr std::array<uint64_t, 4> SQUARE_FILTER_MODULI = {64, 63, 65, 11};
+
+bool passesSquareFilters(const BigNum& num) {
+    static const auto squares = [] {
+        std::array<std::vector<bool>, SQUARE_FILTER_MODULI.size()> result;
+        for (std::size_t i = 0; i < result.size(); i++) {
+            const auto mod = SQUARE_FILTER_MODULI[i];
+            result[i].assign(mod, false);
+            for (uint64_t x = 0; x < mod; x++) {
+                result[i][x * x % mod] = true;
+            }
+        }
+        return result;
+    }();
+
+    const uint64_t residue = num % (64 * 63 * 65 * 11);
+    for (std::size_t i = 0; i < squares.size(); i++) {
+        if (!squares[i][residue % SQUARE_FILTER_MODULI[i]]) {
+            return false;
+        }
     }
+    return true;
+}
 
-    BigNum res = num / 2_bn;
-    BigNum left = 0_bn, right = num;
+} // <anonymous> namespace
 
-    while(true) {
-        BigNum sqr = res * res;
-        BigNum res_plus = res + 1_bn;
-        BigNum res_minus = res - 1_bn;
+BigNum sqrt(const BigNum& num) {
+    return sqrtRem(num).first;
+}
 
-        if (sqr == num) {
-            return res;
+std::pair<BigNum, BigNum> sqrtRem(const BigNum& num) {
+    const auto& digits = num._digits;
+    if (digits.size() <= 2) {
+        /// Below 10^18 double is accurate up to one, which is fixed in integers
+        const uint64_t value = static_cast<uint64_t>(digits[0]) +
+                               (digits.size() == 2 ? static_cast<uint64_t>(digits[1]) * NUM_BASE : 0);
+        auto result = static_cast<uint64_t>(std::sqrt(static_cast<double>(value)));
+        while (result * result > value) {
+            result -= 1;
+        }
+        while ((result + 1) * (result + 1) <= value) {
+            result += 1;
         }
+        return {BigNum(result), BigNum(value - result * result)};
+    }
 
-        if (sqr < num) {
-            if ((res_plus) * (res_plus) > num) {
-                return res;
-            }
+    /// num = high * NUM_BASE^(2 * shift) + low, (sqrt(high) + 1) * NUM_BASE^shift is above sqrt(num)
+    /// and correct in about half of cells, so Newton's iteration from it converges in one or two steps
+    const std::size_t shift = std::max<std::size_t>(digits.size() / 4, 1);
+    const auto high_root = sqrtRem(num._highCells(2 * shift)).first + 1;
+    BigNum result;
+    result._digits.assign(shift, 0);
+    for (const auto cell : high_root._digits) {
+        result._digits.push_back(cell);
+    }
 
-            left = res;
-            try {
-                res = (right + left) * 2 / 4_bn;
-            } catch(std::exception& e) {
-                std::cout << left << std::endl << right << std::endl << std::endl;
-            }
+    /// Iteration from above decreases until it reaches the root
+    while (true) {
+        auto next = (result + num / result) >> 1;
+        if (next >= result) {
+            break;
+        }
+        result = std::move(next);
+    }
+    auto remainder = num - result * result;
+    return {std::move(result), std::move(remainder)};
+}
 
-        } else {
-            if ((res_minus) * (res_minus) < num) {
-                return res_minus;
-            }
-            right = res;
-            try {
-                res = (right + left) * 2 / 4_bn;
-            } catch(std::exception& e) {
-                std::cout << left << std::endl << right << std::endl << std::endl;
-            }
+bool isPerfectSquare(const BigNum& num) {
+    return passesSquareFilters(num) && sqrtRem(num).second == 0;
+}
+
+BigNum root(const BigNum& num, std::size_t degree) {
+    if (degree == 0) {
+        throw std::invalid_argument("Root degree must be positive");
+    }
+    if (degree == 1 || num <= 1_bn) {
+        return num;
+    }
+    if (degree == 2) {
+        return sqrt(num);
+    }
+    const auto bits = bitLength(num);
+    if (degree >= bits) {
+        return 1_bn;
+    }
+
+    /// Newton's iteration x = ((degree - 1) * x + num / x^(degree - 1)) / degree from 2^ceil(bits / degree)
+    const BigNum big_degree(static_cast<uint64_t>(degree));
+    const BigNum previous_degree(static_cast<uint64_t>(degree - 1));
+    BigNum result = 1_bn << ((bits + degree - 1) / degree);
+    while (true) {
+        BigNum power = result;
+        for (std::size_t i = 2; i < degree; i++) {
+            power *= result;
         }
+        auto next = (result * previous_degree + num / power) / big_degree;
+        if (next >= result) {
+            return result;
+        }
+        result = std::move(next);
     }
 }
 
 BigNum logStep(const BigNum& num, const BigNum& base, const BigNum& mod) {
-    if (num == 1_bn) {
+    if (num == 1) {
         return 0_bn;
     }
     BigNum sqrt_mod = sqrt(mod);
     if (sqrt_mod * sqrt_mod != mod) {
-        sqrt_mod = sqrt_mod + 1_bn;
+        sqrt_mod += 1;
     }
 
-    std::map<BigNum, BigNum> base_powers;
-    for (BigNum i = 0_bn; i < sqrt_mod; i = i + 1_bn) {
-        base_powers[powMontgomery(base, i, mod)] = i;
+    /// Table may hold millions of residues, so they are kept packed
+    std::unordered_map<PackedBigNum, PackedBigNum> base_powers;
+    for (BigNum i = 0_bn; i < sqrt_mod; i += 1) {
+        base_powers[PackedBigNum(powMontgomery(base, i, mod))] = PackedBigNum(i);
     }
 
     //calculating the base in mod power to reduce the overall log calculating time
@@ -873,12 +1055,12 @@ BigNum logStep(const BigNum& num, const BigNum& base, const BigNum& mod) {
 
     while (true) {
         BigNum key = multiply(num, curr_base, mod);
-        if (base_powers.count(key) == 1) {
-            return (multiply(index, sqrt_mod, mod) + base_powers[key]) % mod;
+        if (const auto found = base_powers.find(PackedBigNum(key)); found != base_powers.end()) {
+            return (multiply(index, sqrt_mod, mod) + found->second.unpack()) % mod;
         }
 
         curr_base = multiply(curr_base, base_in_power, mod);
-        index = index + 1_bn;
+        index += 1;
     }
 
 }
@@ -895,14 +1077,14 @@ namespace {
 
         if (x < tmp1) {
             x = multiply(element, x, mod);
-            b = add(b, 1_bn, mod - 1_bn);
+            b = add(b, 1_bn, mod - 1);
         } else if (x < tmp2) {
             x = multiply(x, x, mod);
-            a = multiply(2_bn, a, mod - 1_bn);
-            b = multiply(2_bn, b, mod - 1_bn);
+            a = multiply(2_bn, a, mod - 1);
+            b = multiply(2_bn, b, mod - 1);
         } else {
             x = multiply(generator, x, mod);
-            a = add(a, 1_bn, mod - 1_bn);
+            a = add(a, 1_bn, mod - 1);
         }
 
     }
@@ -928,12 +1110,12 @@ BigNum logPollard(const BigNum &generator, BigNum element, BigNum mod) {
         // std::cout << x << "   " << a << "   " << b << "   " << X << "   " << A << "   " << B << std::endl;
 
         if (x == X) {
-            BigNum r = subtract(b, B, mod - 1_bn); // r = b(i) - b(2i);
-            if (r == 0_bn)
+            BigNum r = subtract(b, B, mod - 1); // r = b(i) - b(2i);
+            if (r == 0)
                 return BigNum::inf();
             else {
-                BigNum r_inverted = inverted(r, mod - 1_bn, BigNum::InversionPolicy::Fermat);
-                return multiply(r_inverted, subtract(A, a, mod - 1_bn), mod - 1_bn);
+                BigNum r_inverted = inverted(r, mod - 1, BigNum::InversionPolicy::Fermat);
+                return multiply(r_inverted, subtract(A, a, mod - 1), mod - 1);
             }
 
         }
@@ -946,9 +1128,9 @@ BigNum Pollard_Num(const BigNum& num){
     BigNum b = 2_bn;
     BigNum d;
     for (int i = 0; i >= 0; i++){
-        a = (a * a + 1_bn) % num;
-        b = (b * b + 1_bn) % num;
-        b = (b * b + 1_bn) % num;
+        a = (a * a + 1) % num;
+        b = (b * b + 1) % num;
+        b = (b * b + 1) % num;
         if (a > b){
             d = gcd(a - b, num);
         }
@@ -965,7 +1147,7 @@ BigNum Pollard_Num(const BigNum& num){
     return num;
 }
     std::vector<BigNum> Pollard(const BigNum& num){
-        if (num == 1_bn) return {};
+        if (num == 1) return {};
         BigNum res = Pollard_Num(num);
         std::vector<BigNum> result(Pollard(num/res));
         result.push_back(res);
@@ -976,51 +1158,548 @@ BigNum Pollard_Num(const BigNum& num){
         BigNum N = num;
         std::vector<BigNum> result;
         BigNum a = 2_bn;
-        while (N != 1_bn){
-            if (N % a != 0_bn)
-                a = a + 1_bn;
+        while (N != 1){
+            if (N % a != 0)
+                a += 1;
             else{
                 result.push_back(a);
-                N = N / a;
+                N /= a;
             }
         }
         return result;
     }
 
 
+namespace {
+    /// Trial division looks for factors below this bound, the rest is split by Pollard's rho
+    constexpr uint64_t TRIAL_DIVISION_BOUND = uint64_t{1} << 16;
+
+    /**
+     * @brief Strong probable prime test to bases 2, 3, ..., 41, which has no pseudoprimes below 3.3 * 10^24 (81 bits)
+     */
+    bool isProbablePrime(const BigNum& num) {
+        constexpr std::array<uint64_t, 13> BASES = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41};
+        if (num < 2_bn) {
+            return false;
+        }
+        for (const auto base : BASES) {
+            if (num == base) {
+                return true;
+            }
+            if (num % base == 0) {
+                return false;
+            }
+        }
+
+        /// num - 1 = odd * 2^twos
+        const BarrettReducer ctx(num);
+        const BigNum num_minus_one = num - 1;
+        BigNum odd = num_minus_one;
+        std::size_t twos = 0;
+        while (isEven(odd)) {
+            odd = odd >> 1;
+            twos += 1;
+        }
+
+        for (const auto base : BASES) {
+            BigNum x = pow(BigNum(base), odd, ctx);
+            bool is_witness = (x != 1 && x != num_minus_one);
+            for (std::size_t i = 1; i < twos && is_witness; i++) {
+                x = multiply(x, x, ctx);
+                is_witness = (x != num_minus_one);
+            }
+            if (is_witness) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Nontrivial divisor of odd composite num by Pollard's rho, gcd is taken once per batch of steps
+     */
+    BigNum rhoDivisor(const BigNum& num) {
+        constexpr int BATCH = 64;
+        const BarrettReducer ctx(num);
+        const auto distance = [](const BigNum& x, const BigNum& y) {
+            return x > y ? x - y : y - x;
+        };
+
+        for (uint64_t c = 1;; c++) {
+            const BigNum increment(c);
+            const auto step = [&](const BigNum& x) {
+                return add(multiply(x, x, ctx), increment, ctx);
+            };
+
+            BigNum x = 2_bn;
+            BigNum y = 2_bn;
+            BigNum divisor = 1_bn;
+            while (divisor == 1) {
+                const BigNum x_start = x;
+                const BigNum y_start = y;
+                BigNum product = 1_bn;
+                for (int i = 0; i < BATCH; i++) {
+                    x = step(x);
+                    y = step(step(y));
+                    product = multiply(product, distance(x, y), ctx);
+                }
+                divisor = gcd(product, num);
+
+                /// Batch met several factors or the cycle closed, so it is replayed one step at a time
+                if (divisor == num) {
+                    x = x_start;
+                    y = y_start;
+                    divisor = 1_bn;
+                    for (int i = 0; i < BATCH && divisor == 1; i++) {
+                        x = step(x);
+                        y = step(step(y));
+                        divisor = gcd(distance(x, y), num);
+                    }
+                }
+            }
+            if (divisor != num) {
+                return divisor;
+            }
+        }
+    }
+} // namespace
+
     std::vector<std::pair<BigNum, BigNum>> factorization(BigNum n) {
         std::vector<std::pair<BigNum, BigNum>> result;
-        for (BigNum i = 2_bn; i * i <= n; i = i + 1_bn) {
+        const BigNum bound(TRIAL_DIVISION_BOUND);
+        for (BigNum i = 2_bn; i < bound && i * i <= n; i += 1) {
             BigNum k = 0_bn;
-            while (n % i == 0_bn) {
-                k = k + 1_bn;
-                n = n / i;
+            while (n % i == 0) {
+                k += 1;
+                n /= i;
             }
-            if (k != 0_bn) result.emplace_back(i, k);
+            if (k != 0) result.emplace_back(i, k);
 
         }
-        if (n != 1_bn)
-            result.emplace_back(n, 1_bn);
+        if (n == 1) {
+            return result;
+        }
+
+        /// Factors left are above the bound, composite rest is split until only primes remain
+        std::vector<BigNum> pending = {n};
+        std::vector<BigNum> primes;
+        while (!pending.empty()) {
+            const BigNum num = pending.back();
+            pending.pop_back();
+            if (isProbablePrime(num)) {
+                primes.push_back(num);
+                continue;
+            }
+            const BigNum divisor = rhoDivisor(num);
+            pending.push_back(divisor);
+            pending.push_back(num / divisor);
+        }
+
+        std::sort(primes.begin(), primes.end());
+        for (const auto& prime : primes) {
+            if (result.empty() || result.back().first != prime) {
+                result.emplace_back(prime, 0_bn);
+            }
+            result.back().second += 1;
+        }
         return result;
     }
 
 
+std::vector<uint64_t> toWords(const BigNum& num) {
+    std::vector<uint64_t> words;
+    toWords(words, num);
+    return words;
+}
+
+BigNum fromWords(const std::vector<uint64_t>& words) {
+    BigNum result;
+    fromWords(result, words);
+    return result;
+}
+
+void toWords(std::vector<uint64_t>& words, const BigNum& num) {
+    constexpr uint64_t HALF_WORD = uint64_t{1} << 32;
+
+    /// Cells are divided in place, buffer of the calling thread keeps them between calls
+    thread_local std::vector<int64_t> rest;
+    rest.assign(num._digits.rbegin(), num._digits.rend());
+    words.clear();
+    bool is_low_half = true;
+    while (!rest.empty()) {
+        /// Division of big endian rest by 2^32
+        uint64_t remainder = 0;
+        for (auto& digit : rest) {
+            const uint64_t temp = remainder * NUM_BASE + static_cast<uint64_t>(digit);
+            digit = static_cast<int64_t>(temp / HALF_WORD);
+            remainder = temp % HALF_WORD;
+        }
+        rest.erase(rest.begin(), std::find_if(rest.begin(), rest.end(), [](int64_t digit) { return digit != 0; }));
+
+        if (is_low_half) {
+            words.push_back(remainder);
+        } else {
+            words.back() |= remainder << 32;
+        }
+        is_low_half = !is_low_half;
+    }
+    if (words.empty()) {
+        words.push_back(0);
+    }
+}
+
+void fromWords(BigNum& result, const std::vector<uint64_t>& words) {
+    result._digits.assign(1, 0);
+    for (auto word = words.rbegin(); word != words.rend(); ++word) {
+        for (const uint64_t half : {*word >> 32, *word & 0xFFFFFFFFu}) {
+            /// result = result * 2^32 + half
+            uint64_t addition = half;
+            for (auto& digit : result._digits) {
+                const uint64_t temp = (static_cast<uint64_t>(digit) << 32) + addition;
+                digit = static_cast<int64_t>(temp % NUM_BASE);
+                addition = temp / NUM_BASE;
+            }
+            while (addition != 0) {
+                result._digits.push_back(static_cast<int64_t>(addition % NUM_BASE));
+                addition /= NUM_BASE;
+            }
+        }
+    }
+    result._trim();
+}
+
+namespace {
+
+/**
+ * @brief Arithmetic on little-endian words for jacobi(), numbers are kept without leading zero words
+ */
+void trimWords(std::vector<uint64_t>& words) {
+    while (!words.empty() && words.back() == 0) {
+        words.pop_back();
+    }
+}
+
+bool lessWords(const std::vector<uint64_t>& left, const std::vector<uint64_t>& right) {
+    if (left.size() != right.size()) {
+        return left.size() < right.size();
+    }
+    return std::lexicographical_compare(left.rbegin(), left.rend(), right.rbegin(), right.rend());
+}
+
+/**
+ * @brief left -= right for left >= right
+ */
+void subtractWords(std::vector<uint64_t>& left, const std::vector<uint64_t>& right) {
+    uint64_t borrow = 0;
+    for (std::size_t i = 0; i < left.size(); i++) {
+        const uint64_t subtrahend = i < right.size() ? right[i] : 0;
+        const uint64_t difference = left[i] - subtrahend - borrow;
+        borrow = (left[i] < subtrahend || (left[i] == subtrahend && borrow != 0)) ? 1 : 0;
+        left[i] = difference;
+    }
+    trimWords(left);
+}
+
+/**
+ * @brief Removes trailing zero bits of nonzero number
+ * @return Count of removed bits
+ */
+std::size_t stripTrailingZeros(std::vector<uint64_t>& words) {
+    const auto first = std::find_if(words.begin(), words.end(), [](uint64_t word) { return word != 0; });
+    const auto zero_words = static_cast<std::size_t>(first - words.begin());
+    words.erase(words.begin(), first);
+
+    std::size_t bits = 0;
+    while (((words.front() >> bits) & 1) == 0) {
+        bits += 1;
+    }
+    if (bits != 0) {
+        for (std::size_t i = 0; i < words.size(); i++) {
+            const uint64_t next = i + 1 < words.size() ? words[i + 1] : 0;
+            words[i] = (words[i] >> bits) | (next << (64 - bits));
+        }
+        trimWords(words);
+    }
+    return zero_words * 64 + bits;
+}
+
+} // <anonymous> namespace
+
+int jacobi(const BigNum& num, const BigNum& mod) {
+    if (isEven(mod)) {
+        throw std::invalid_argument("Jacobi symbol is defined for odd modulo only");
+    }
+
+    auto a = toWords(num < mod ? num : num % mod);
+    auto n = toWords(mod);
+    trimWords(a);
+    trimWords(n);
+
+    int result = 1;
+    while (!a.empty()) {
+        /// (2 / n) = -1 exactly for n = 3, 5 (mod 8)
+        const auto shift = stripTrailingZeros(a);
+        const auto n_mod_8 = n.front() & 7;
+        if (shift % 2 == 1 && (n_mod_8 == 3 || n_mod_8 == 5)) {
+            result = -result;
+        }
+
+        /// Quadratic reciprocity for odd a and n: the sign changes if both are 3 (mod 4)
+        if (lessWords(a, n)) {
+            std::swap(a, n);
+            if ((a.front() & 3) == 3 && (n.front() & 3) == 3) {
+                result = -result;
+            }
+        }
+        subtractWords(a, n);
+    }
+    return n.size() == 1 && n.front() == 1 ? result : 0;
+}
+
+namespace {
+    /**
+     * @return Value of digit character in bases up to 36, or 36 if character is not a digit
+     */
+    int digitValue(char symbol) noexcept {
+        if ('0' <= symbol && symbol <= '9') {
+            return symbol - '0';
+        }
+        if ('a' <= symbol && symbol <= 'z') {
+            return symbol - 'a' + 10;
+        }
+        if ('A' <= symbol && symbol <= 'Z') {
+            return symbol - 'A' + 10;
+        }
+        return 36;
+    }
+
+    /**
+     * @brief Divide-and-conquer conversion between BigNum and digits in arbitrary base:
+     *        num = high * base^(leaf * 2^k) + low, where powers are squared once and reused by every level
+     */
+    class RadixConverter
+    {
+    public:
+        explicit RadixConverter(int base)
+            : _base(base)
+        {
+            /// Leaves are converted within one machine word
+            uint64_t power = _base;
+            while (power <= std::numeric_limits<uint64_t>::max() / _base) {
+                power *= _base;
+                ++_leaf_digits;
+            }
+            _powers.emplace_back(power);
+        }
+
+        BigNum parse(const char* digits, std::size_t count) {
+            if (count <= _leaf_digits) {
+                uint64_t value = 0;
+                for (std::size_t pos = 0; pos < count; ++pos) {
+                    value = value * _base + digitValue(digits[pos]);
+                }
+                return BigNum(value);
+            }
+
+            /// Low part takes leaf * 2^level digits, the largest such count below count
+            std::size_t level = 0;
+            while ((_leaf_digits << (level + 1)) < count) {
+                ++level;
+            }
+            const std::size_t low_count = _leaf_digits << level;
+            auto result = parse(digits, count - low_count) * _power(level);
+            result += parse(digits + count - low_count, low_count);
+            return result;
+        }
+
+        /**
+         * @brief Writes digits of num padded with zeros to @a width
+         * @return Pointer past the last written character
+         * @throw std::invalid_argument if digits don't fit into [first, last)
+         */
+        char* write(char* first, char* last, const BigNum& num, std::size_t width) {
+            if (num < _powers[0]) {
+                return _writeWord(first, last, lowBits(num, 64), width);
+            }
+
+            /// Split at the largest cached power not above num, so both parts are shorter than num
+            std::size_t level = 0;
+            while (_power(level + 1) <= num) {
+                ++level;
+            }
+            const std::size_t low_width = _leaf_digits << level;
+            const auto [high, low] = extract(num, _powers[level]);
+            first = write(first, last, high, width > low_width ? width - low_width : 0);
+            return write(first, last, low, low_width);
+        }
+
+    private:
+        /**
+         * @return base^(leaf * 2^level)
+         */
+        const BigNum& _power(std::size_t level) {
+            while (_powers.size() <= level) {
+                _powers.push_back(_powers.back() * _powers.back());
+            }
+            return _powers[level];
+        }
+
+        char* _writeWord(char* first, char* last, uint64_t value, std::size_t width) const {
+            char text[64];
+            std::size_t count = 0;
+            do {
+                text[count++] = "0123456789abcdefghijklmnopqrstuvwxyz"[value % _base];
+                value /= _base;
+            } while (value != 0);
+
+            const std::size_t total = std::max(width, count);
+            if (static_cast<std::size_t>(last - first) < total) {
+                throw std::invalid_argument("Buffer is too small for number");
+            }
+            first = std::fill_n(first, total - count, '0');
+            return std::reverse_copy(text, text + count, first);
+        }
+
+        uint64_t _base;
+        std::size_t _leaf_digits = 1;
+        std::vector<BigNum> _powers;
+    };
+
+    /**
+     * @brief Converter of given base kept for the thread, so powers squared for one number serve the next ones
+     * @note Table holds powers up to the longest number converted so far
+     */
+    RadixConverter& converterFor(int base) {
+        thread_local std::array<std::optional<RadixConverter>, 37> converters;
+        auto& converter = converters[static_cast<std::size_t>(base)];
+        if (!converter) {
+            converter.emplace(base);
+        }
+        return *converter;
+    }
+
+    /**
+     * @return Count of decimal digits of num, cells below the top one are padded to SECTION_DIGITS
+     */
+    template <typename Cells>
+    std::size_t decimalDigits(const Cells& cells) {
+        const int64_t top = cells.empty() ? 0 : cells.back();
+        std::size_t top_digits = 1;
+        for (int64_t rest = top / 10; rest != 0; rest /= 10) {
+            ++top_digits;
+        }
+        return top_digits + (cells.size() > 1 ? (cells.size() - 1) * SECTION_DIGITS : 0);
+    }
+} // <anonymous> namespace
+
+BigNum fromChars(const char* first, const char* last, int base) {
+    if (base < 2 || base > 36) {
+        throw std::invalid_argument("Base must be in range [2, 36]");
+    }
+    if (first == last) {
+        throw std::invalid_argument("Number must have digits");
+    }
+    for (auto symbol = first; symbol != last; ++symbol) {
+        if (digitValue(*symbol) >= base) {
+            throw std::invalid_argument("Invalid digit for given base");
+        }
+    }
+
+    if (base == 10) {
+        return BigNum(std::string_view(first, static_cast<std::size_t>(last - first)));
+    }
+    return converterFor(base).parse(first, static_cast<std::size_t>(last - first));
+}
+
+std::size_t maxChars(const BigNum& num, int base) {
+    if (base < 2 || base > 36) {
+        throw std::invalid_argument("Base must be in range [2, 36]");
+    }
+    const std::size_t decimal_digits = decimalDigits(num._digits);
+    if (base == 10) {
+        return decimal_digits;
+    }
+    return static_cast<std::size_t>(std::ceil(decimal_digits * std::log(10.0) / std::log(base))) + 1;
+}
+
+char* toChars(char* first, char* last, const BigNum& num, int base) {
+    if (base < 2 || base > 36) {
+        throw std::invalid_argument("Base must be in range [2, 36]");
+    }
+    if (base != 10) {
+        return converterFor(base).write(first, last, num, 0);
+    }
+
+    /// Cells are decimal: the top one is written as is, the rest are padded to SECTION_DIGITS
+    const std::size_t cells = num._digits.size();
+    const int64_t top = cells == 0 ? 0 : num._digits[cells - 1];
+    const std::size_t count = decimalDigits(num._digits);
+    if (static_cast<std::size_t>(last - first) < count) {
+        throw std::invalid_argument("Buffer is too small for number");
+    }
+
+    char* end = first + count;
+    char* pos = end;
+    for (std::size_t cell = 0; cell + 1 < cells; ++cell) {
+        int64_t value = num._digits[cell];
+        for (int digit = 0; digit < SECTION_DIGITS; ++digit) {
+            *--pos = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+    }
+    int64_t value = top;
+    do {
+        *--pos = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    return end;
+}
+
+std::size_t byteLength(const BigNum& num) {
+    return (bitLength(num) + 7) / 8;
+}
+
+BigNum fromBytes(const std::byte* data, std::size_t size, Endian order) {
+    std::vector<uint64_t> words((size + 7) / 8, 0);
+    for (std::size_t i = 0; i < size; ++i) {
+        /// Position of byte counted from the least significant one
+        const std::size_t position = order == Endian::Little ? i : size - 1 - i;
+        words[position / 8] |= static_cast<uint64_t>(data[i]) << (position % 8 * 8);
+    }
+    return fromWords(words);
+}
+
+void toBytes(const BigNum& num, std::byte* data, std::size_t width, Endian order) {
+    const auto words = toWords(num);
+    for (std::size_t position = width; position < words.size() * 8; ++position) {
+        if (((words[position / 8] >> (position % 8 * 8)) & 0xFF) != 0) {
+            throw std::invalid_argument("Number doesn't fit into given width");
+        }
+    }
+    for (std::size_t position = 0; position < width; ++position) {
+        const uint64_t word = position / 8 < words.size() ? words[position / 8] : 0;
+        const auto value = static_cast<std::byte>(word >> (position % 8 * 8));
+        data[order == Endian::Little ? position : width - 1 - position] = value;
+    }
+}
+
 BigNum totientEulerFunc(BigNum mod) {
     BigNum result = mod;
-    for(auto i = 2_bn; i * i <= mod; i = i + 1_bn) {
-        if(mod % i == 0_bn) {
-            while(mod % i == 0_bn) mod = mod / i;
-            result = result - (result / i);
+    for(auto i = 2_bn; i * i <= mod; i = i + 1) {
+        if(mod % i == 0) {
+            while(mod % i == 0) mod /= i;
+            result -= result / i;
         }
     }
-    if(mod > 1_bn) result = result - (result / mod);
+    if(mod > 1_bn) result -= result / mod;
     return result;
 }
 
 BigNum elementOrder(const BigNum &num, const BigNum &mod) {
-    if(gcd(num, mod) != 1_bn){
+    if(gcd(num, mod) != 1){
         throw std::invalid_argument("Not an element of the group. Nums must be coprime");
     }
+    const BarrettReducer ctx(mod);
     /// Group order.
     BigNum result = totientEulerFunc(mod);
     /// Prime factorization of group order.
@@ -1028,11 +1707,11 @@ BigNum elementOrder(const BigNum &num, const BigNum &mod) {
     BigNum temp;
 
     for(const auto& i : pf) {
-        result = result / pow(i.first, i.second, mod);
-        temp = pow(num, result, mod);
-        while(temp != 1_bn) {
-            temp = pow(temp, i.first, mod);
-            result = result * i.first;
+        result /= pow(i.first, i.second, ctx);
+        temp = pow(num, result, ctx);
+        while(temp != 1) {
+            temp = pow(temp, i.first, ctx);
+            result *= i.first;
         }
     }
     return result;
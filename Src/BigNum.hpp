@@ -8,9 +8,94 @@
 #include <vector>
 #include <string>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <functional>
+
+#include "SmallVector.hpp"
 
 namespace lab {
 
+class BarrettReducer;
+class PackedBigNum;
+
+namespace detail {
+    /// Base of BigNum cells and count of decimal digits in one cell
+    inline constexpr int64_t CELL_BASE = 1000000000;
+    inline constexpr std::size_t CELL_DIGITS = 9;
+
+    /**
+     * @brief Decimal integer literal split into BigNum cells at compile time, least significant cell first
+     */
+    template <char... Chars>
+    struct DecimalLiteral {
+        static_assert(((('0' <= Chars && Chars <= '9') || Chars == '\'') && ...),
+                      "BigNum literal must be a decimal integer");
+
+        static constexpr char TEXT[] = {Chars...};
+
+        static constexpr std::size_t significantDigits() {
+            std::size_t count = 0;
+            for (const char symbol : TEXT) {
+                if (symbol != '\'' && (count != 0 || symbol != '0')) {
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+        static constexpr std::size_t SIZE = significantDigits() == 0
+                                          ? 1
+                                          : (significantDigits() + CELL_DIGITS - 1) / CELL_DIGITS;
+
+        static constexpr std::array<int64_t, SIZE> parse() {
+            std::array<int64_t, SIZE> cells{};
+            std::size_t position = 0;
+            int64_t scale = 1;
+            for (std::size_t i = sizeof...(Chars); i-- > 0;) {
+                if (TEXT[i] == '\'') {
+                    continue;
+                }
+                if (position / CELL_DIGITS < SIZE) {
+                    cells[position / CELL_DIGITS] += (TEXT[i] - '0') * scale;
+                }
+                ++position;
+                scale = position % CELL_DIGITS == 0 ? 1 : scale * 10;
+            }
+            return cells;
+        }
+
+        static constexpr std::array<int64_t, SIZE> CELLS = parse();
+    };
+
+    /**
+     * @brief Final mixer of splitmix64, spreads every input bit over the whole word
+     */
+    constexpr uint64_t mixBits(uint64_t value) noexcept {
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+
+    /**
+     * @brief Hash of trimmed cells, shared by every type storing BigNum cells so equal numbers hash equally
+     */
+    template <typename Cell>
+    std::size_t hashCells(const Cell* cells, std::size_t count) noexcept {
+        /// Two cells fit into one word, so each multiplication mixes 60 bits of number
+        uint64_t result = count;
+        for (std::size_t i = 0; i < count; i += 2) {
+            uint64_t word = static_cast<uint64_t>(cells[i]);
+            if (i + 1 < count) {
+                word += static_cast<uint64_t>(cells[i + 1]) * CELL_BASE;
+            }
+            result = (result ^ word) * 0x9E3779B97F4A7C15ull;
+        }
+        return static_cast<std::size_t>(mixBits(result));
+    }
+} // namespace detail
+
 /**
  * @brief Class for holding big positive integers
  */
@@ -19,16 +104,77 @@ class BigNum
 public:
     BigNum(const BigNum& that) = default;
 
+    BigNum(BigNum&& that) noexcept = default;
+
     explicit BigNum(std::string_view num_str);
 
+    /**
+     * @brief Builds number from machine word without parsing
+     */
+    explicit BigNum(uint64_t value);
+
+    /**
+     * @brief Builds number from cells in base 10^9, least significant first, without leading zero cells
+     * @note Constructor is constexpr, but BigNum isn't a literal type, so a namespace scope BigNum constant
+     *       still registers its destructor at load. Constants needed at compile time use _fbn literals
+     *       of FixedBigNum.hpp
+     */
+    template <std::size_t N>
+    constexpr explicit BigNum(const std::array<int64_t, N>& cells)
+        : _digits(cells)
+    { }
+
     BigNum() = default;
 
     BigNum& operator=(const BigNum& that) = default;
 
+    BigNum& operator=(BigNum&& that) noexcept = default;
+
+    /**
+     * @brief In-place arithmetic, cells of this number are reused
+     * @note this number must not be less than right number in subtraction
+     */
+    BigNum& operator+=(const BigNum& right);
+    BigNum& operator-=(const BigNum& right);
+    BigNum& operator*=(const BigNum& right);
+    BigNum& operator/=(const BigNum& right);
+    BigNum& operator%=(const BigNum& right);
+    BigNum& operator+=(uint64_t right);
+    BigNum& operator-=(uint64_t right);
+
+    /**
+     * @brief Multiplies or divides number by 2^shift
+     * @note Cells are decimal, so shifting costs one pass over cells per 29 bits
+     */
+    BigNum& operator<<=(std::size_t shift);
+    BigNum& operator>>=(std::size_t shift);
+
+    void swap(BigNum& that) noexcept;
+    friend void swap(BigNum& left, BigNum& right) noexcept;
+
     friend std::string to_string(const BigNum& num);
 
+    /**
+     * @brief Writes digits of num in base from 2 to 36 into [first, last), letters are lowercase
+     * @note Decimal output is formatted straight from cells, other bases are converted by divide and conquer
+     * @return Pointer past the last written character
+     * @throw std::invalid_argument if base is out of range or digits don't fit, see maxChars()
+     */
+    friend char* toChars(char* first, char* last, const BigNum& num, int base);
+
+    /**
+     * @return Count of characters toChars() writes for decimal, upper bound for other bases
+     */
+    friend std::size_t maxChars(const BigNum& num, int base);
+
     static const BigNum& inf();
 
+    /**
+     * @brief Three-way comparison: count of cells first, then one scan from the most significant cell
+     * @return Negative if left < right, zero if they are equal, positive otherwise
+     */
+    friend int compare(const BigNum& left, const BigNum& right) noexcept;
+
     friend bool operator<(const BigNum& left, const BigNum& right) noexcept;
     friend bool operator<=(const BigNum& left, const BigNum& right) noexcept;
     friend bool operator>(const BigNum& left, const BigNum& right) noexcept;
@@ -36,6 +182,17 @@ public:
     friend bool operator==(const BigNum& left, const BigNum& right) noexcept;
     friend bool operator!=(const BigNum& left, const BigNum& right) noexcept;
 
+    /**
+     * @brief Hash mixing all cells, equal numbers have equal hashes
+     */
+    friend std::size_t hash(const BigNum& num) noexcept;
+
+    /**
+     * @brief Hash of the lowest cell only, i.e. of num % NUM_BASE
+     * @note Good enough and cheaper for uniformly distributed residues, poor for arbitrary numbers
+     */
+    friend std::size_t hashLowCell(const BigNum& num) noexcept;
+
     /**
      * @note left number must be bigger than right number
      */
@@ -46,6 +203,75 @@ public:
     friend BigNum operator%(const BigNum& left, const BigNum& right);
     friend BigNum operator*(const BigNum& left, int right);
 
+    /**
+     * @brief Mixed operations with machine words, right operand never becomes a temporary BigNum
+     * @note left number must not be less than right number in subtraction
+     */
+    friend BigNum operator+(const BigNum& left, uint64_t right);
+    friend BigNum operator-(const BigNum& left, uint64_t right);
+    friend uint64_t operator%(const BigNum& left, uint64_t right);
+    friend bool operator==(const BigNum& left, uint64_t right) noexcept;
+    friend bool operator!=(const BigNum& left, uint64_t right) noexcept;
+
+    friend BigNum operator<<(BigNum num, std::size_t shift);
+    friend BigNum operator>>(BigNum num, std::size_t shift);
+
+    /**
+     * @brief Parity is read from the lowest cell, as NUM_BASE is even
+     */
+    friend bool isOdd(const BigNum& num) noexcept;
+    friend bool isEven(const BigNum& num) noexcept;
+
+    /**
+     * @return num % 2^count, taken from the lowest cell for count up to 9 as 2^9 divides NUM_BASE
+     * @throw std::invalid_argument if count is bigger than 64
+     */
+    friend uint64_t lowBits(const BigNum& num, std::size_t count);
+
+    /**
+     * @return Count of binary digits, zero for zero
+     * @note Cells are decimal, so this converts num by toWords(), which takes time quadratic in count of cells.
+     *       The same holds for popcount() and operator&, loops over bits should call toWords() once instead
+     */
+    friend std::size_t bitLength(const BigNum& num);
+
+    /**
+     * @return Binary digit at position @a bit
+     * @note Digits from 9 on are read after shifting the whole number, see bitLength()
+     */
+    friend bool testBit(const BigNum& num, std::size_t bit);
+
+    /**
+     * @return Count of nonzero binary digits
+     * @note Converts num to binary words, see bitLength()
+     */
+    friend std::size_t popcount(const BigNum& num);
+
+    /**
+     * @brief Bitwise and, both numbers are converted to binary words and back, see bitLength()
+     */
+    friend BigNum operator&(const BigNum& left, const BigNum& right);
+
+    /**
+     * @brief Output-parameter arithmetic, result is written into @a out and its cells are reused,
+     *        so loops over numbers which fit into inline storage never allocate.
+     *        Named apart from add/subtract/multiply(first, second, mod) to keep those calls unambiguous
+     * @note out may be one of operands
+     */
+    friend void addInto(BigNum& out, const BigNum& left, const BigNum& right);
+    friend void subtractInto(BigNum& out, const BigNum& left, const BigNum& right);
+    friend void multiplyInto(BigNum& out, const BigNum& left, const BigNum& right);
+
+    /**
+     * @brief Overloads for temporary operands, result takes over cells of the temporary
+     */
+    friend BigNum operator+(BigNum&& left, const BigNum& right);
+    friend BigNum operator+(const BigNum& left, BigNum&& right);
+    friend BigNum operator+(BigNum&& left, BigNum&& right);
+    friend BigNum operator-(BigNum&& left, const BigNum& right);
+    friend BigNum operator+(BigNum&& left, uint64_t right);
+    friend BigNum operator-(BigNum&& left, uint64_t right);
+
     template<typename OStream>
     friend OStream& operator<<(OStream& os, const BigNum& num);
     template<typename IStream>
@@ -95,10 +321,17 @@ public:
     friend BigNum inverted(const BigNum& num, const BigNum& mod, InversionPolicy policy);
 
     /**
-     * @brief Finds square root of @a num modulo @a mod using Tonelli–Shanks algorithm
+     * @brief Finds square root of @a num modulo prime @a mod, see SqrtContext
      */
     friend std::optional<std::pair<BigNum, BigNum>> sqrt(const BigNum& num, const BigNum& mod);
 
+    /**
+     * @brief Jacobi symbol (num / mod) by binary algorithm, only shifts and subtractions of 64-bit words
+     * @return -1, 0 or 1, for prime @a mod it is Legendre symbol, so -1 means num isn't a quadratic residue
+     * @throw std::invalid_argument if @a mod is even
+     */
+    friend int jacobi(const BigNum& num, const BigNum& mod);
+
     /**
      * @brief Converts number to vector of its digits
      * @return Vector of digits
@@ -139,10 +372,28 @@ public:
      */
     friend BigNum powMontgomery(const BigNum& base, BigNum degree, const BigNum& mod);
 
-    /*
-     * @brief Finds square root of num*/
+    /**
+     * @brief Integer square root, rounded down
+     */
     friend BigNum sqrt(const BigNum& num);
 
+    /**
+     * @return Integer square root s and remainder num - s^2
+     * @note Newton's iteration started from the root of the upper half of cells, so it takes a couple of divisions per level
+     */
+    friend std::pair<BigNum, BigNum> sqrtRem(const BigNum& num);
+
+    /**
+     * @brief Checks residues modulo 64, 63, 65 and 11 first, they reject all but 0.6% of non-squares without taking the root
+     */
+    friend bool isPerfectSquare(const BigNum& num);
+
+    /**
+     * @brief Integer root of given degree, rounded down
+     * @throw std::invalid_argument if degree is zero
+     */
+    friend BigNum root(const BigNum& num, std::size_t degree);
+
     /* @brief Finds log with given base and num
      * */
     friend BigNum logStep(const BigNum&, const BigNum&, const BigNum&);
@@ -173,20 +424,133 @@ public:
 
 
      /**
-      * @brief Factorizes BigNum
-      * @return Vector of pairs where in pair first number is prime and second is its exponent
+      * @brief Factorizes BigNum, factors below 2^16 are found by trial division and larger ones by Pollard's rho
+      * @return Vector of pairs where in pair first number is prime and second is its exponent, primes ascend
+      * @note Primality of large factors is checked by Miller-Rabin test, exact for numbers of at most 81 bits.
+      *       Running time grows as fourth root of num for semiprimes, so numbers up to about 100 bits are practical
       * */
      friend std::vector<std::pair<BigNum, BigNum>> factorization(BigNum num);
 
+    /**
+     * @brief Converts number to binary representation, cells are divided by 2^32 one pass per half word,
+     *        so it takes time quadratic in count of cells
+     * @return Little-endian array of 64-bit words, zero is a single zero word
+     */
+    friend std::vector<uint64_t> toWords(const BigNum& num);
+
+    /**
+     * @brief Builds number from little-endian array of 64-bit words
+     */
+    friend BigNum fromWords(const std::vector<uint64_t>& words);
+
+    /**
+     * @brief Conversions into existing storage, which is reused when it is big enough
+     */
+    friend void toWords(std::vector<uint64_t>& words, const BigNum& num);
+    friend void fromWords(BigNum& result, const std::vector<uint64_t>& words);
+
 private:
+    friend class BarrettReducer;
+    friend class PackedBigNum;
+
+    /**
+     * @brief Removes leading zero cells, zero is kept as a single cell
+     */
+    void _trim();
+
+    /**
+     * @return Number formed by cells starting from @a from, i.e. num / NUM_BASE^from
+     */
+    BigNum _highCells(std::size_t from) const;
+
+    /**
+     * @return Number formed by first @a count cells, i.e. num % NUM_BASE^count
+     */
+    BigNum _lowCells(std::size_t count) const;
+
+    /**
+     * @brief Count of cells kept without heap allocation: 521-bit numbers take 18 cells,
+     *        so do products of two 256-bit ones
+     */
+    static constexpr std::size_t INLINE_CELLS = 20;
+
+    using Digits = SmallVector<int64_t, INLINE_CELLS>;
+
     /// Array of coefficients in representation
-    std::vector<int64_t> _digits;
+    Digits _digits;
+};
+
+std::vector<uint64_t> toWords(const BigNum& num);
+BigNum fromWords(const std::vector<uint64_t>& words);
+void toWords(std::vector<uint64_t>& words, const BigNum& num);
+void fromWords(BigNum& result, const std::vector<uint64_t>& words);
+std::size_t hash(const BigNum& num) noexcept;
+
+/**
+ * @brief Parses digits in base from 2 to 36, letters of either case stand for digits above 9
+ * @note Decimal input is split into cells directly, other bases are converted by divide and conquer
+ *       using fast multiplication, so millions of digits are fine
+ * @throw std::invalid_argument if range is empty, base is out of range or a character isn't a digit
+ */
+BigNum fromChars(const char* first, const char* last, int base = 10);
+char* toChars(char* first, char* last, const BigNum& num, int base = 10);
+std::size_t maxChars(const BigNum& num, int base = 10);
+
+/**
+ * @brief Order of bytes in binary encoding of number
+ */
+enum class Endian {
+    Big,
+    Little
+};
+
+/**
+ * @return Count of bytes in binary encoding of num without leading zeros, zero for zero
+ */
+std::size_t byteLength(const BigNum& num);
+
+/**
+ * @brief Builds number from @a size bytes, leading zero bytes are allowed
+ */
+BigNum fromBytes(const std::byte* data, std::size_t size, Endian order);
+
+/**
+ * @brief Writes num into exactly @a width bytes padded with zeros, field elements keep their size this way
+ * @throw std::invalid_argument if num needs more than width bytes
+ */
+void toBytes(const BigNum& num, std::byte* data, std::size_t width, Endian order);
+
+/**
+ * @brief Hasher for tables keyed by uniformly distributed residues, see hashLowCell()
+ */
+struct LowCellHash {
+    std::size_t operator()(const BigNum& num) const noexcept {
+        return hashLowCell(num);
+    }
 };
 
 template<typename OStream>
 OStream& operator<<(OStream& os, const BigNum& num)
 {
-    os << to_string(num);
+    /// Cells are written one by one from a buffer on stack, no string is built
+    char text[detail::CELL_DIGITS];
+    const std::size_t cells = num._digits.size();
+    for (std::size_t cell = cells; cell-- > 0;) {
+        int64_t value = num._digits[cell];
+        std::size_t begin = detail::CELL_DIGITS;
+        do {
+            text[--begin] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        if (cell + 1 != cells) {
+            std::fill(text, text + begin, '0');
+            begin = 0;
+        }
+        os << std::string_view(text + begin, detail::CELL_DIGITS - begin);
+    }
+    if (cells == 0) {
+        os << '0';
+    }
     return os;
 }
 
@@ -199,8 +563,21 @@ IStream& operator>>(IStream& is, BigNum& num) {
 }
 
 
-inline lab::BigNum operator""_bn(const char* str) {
-    return lab::BigNum(str);
+/**
+ * @brief Digits of literal are split into cells during compilation, so only copying is left for runtime
+ */
+template <char... Chars>
+inline lab::BigNum operator""_bn() {
+    return lab::BigNum(detail::DecimalLiteral<Chars...>::CELLS);
 }
 
 } // namespace lab
+
+namespace std {
+template <>
+struct hash<lab::BigNum> {
+    std::size_t operator()(const lab::BigNum& num) const noexcept {
+        return lab::hash(num);
+    }
+};
+} // namespace std
@@ -0,0 +1,364 @@
+#pragma once
+
+#include "BigNum.hpp"
+#include "Modulus.hpp"
+
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lab {
+
+/**
+ * @brief Field backend over generic BigNum, reduction goes through Modulus
+ * @note Every field backend provides Element, fromBigNum, toBigNum, zero, one,
+ *       add, sub, mul, sqr and inverse, elements are compared with ==.
+ *       Backends with heap allocated elements also provide out-parameter addInto, subInto,
+ *       mulInto, sqrInto and inverseInto, which BasicEllipticCurve prefers
+ */
+class BigNumField
+{
+public:
+    using Element = BigNum;
+
+    BigNumField() = default;
+
+    explicit BigNumField(const Modulus& mod) : _mod(mod) {}
+
+    const BigNum& modulo() const noexcept {
+        return _mod.modulo();
+    }
+
+    Element fromBigNum(const BigNum& num) const {
+        return _mod.reduce(num);
+    }
+
+    BigNum toBigNum(const Element& num) const {
+        return num;
+    }
+
+    Element zero() const {
+        return 0_bn;
+    }
+
+    Element one() const {
+        return _mod.reduce(1_bn);
+    }
+
+    Element add(const Element& left, const Element& right) const {
+        return lab::add(left, right, _mod);
+    }
+
+    Element sub(const Element& left, const Element& right) const {
+        return lab::subtract(left, right, _mod);
+    }
+
+    Element mul(const Element& left, const Element& right) const {
+        return lab::multiply(left, right, _mod);
+    }
+
+    Element sqr(const Element& num) const {
+        return lab::multiply(num, num, _mod);
+    }
+
+    Element inverse(const Element& num) const {
+        return lab::inverted(num, _mod, BigNum::InversionPolicy::Fermat);
+    }
+
+    /**
+     * @brief Out-parameter operations, out must not alias operands.
+     *        With reused outputs they allocate only while cells grow, up to Karatsuba's threshold
+     */
+    void addInto(Element& out, const Element& left, const Element& right) const {
+        addMod(out, left, right, _mod);
+    }
+
+    void subInto(Element& out, const Element& left, const Element& right) const {
+        subMod(out, left, right, _mod);
+    }
+
+    void mulInto(Element& out, const Element& left, const Element& right) const {
+        mulMod(out, left, right, _mod);
+    }
+
+    void sqrInto(Element& out, const Element& num) const {
+        sqrMod(out, num, _mod);
+    }
+
+    /**
+     * @brief Fermat inversion num^(p - 2) replayed from recoding cached in Modulus
+     * @throw std::invalid_argument if num is zero
+     */
+    void inverseInto(Element& out, const Element& num) const {
+        if (num == 0) {
+            throw std::invalid_argument("Nums must be coprime.");
+        }
+        _mod.pow(out, num, _mod.inversionExponent());
+    }
+
+private:
+    Modulus _mod;
+};
+
+namespace detail {
+    /**
+     * @brief Whether field backend provides out-parameter operations
+     */
+    template <typename FieldT, typename = void>
+    struct HasInPlaceOps : std::false_type {};
+
+    template <typename FieldT>
+    struct HasInPlaceOps<FieldT, std::void_t<decltype(&FieldT::inverseInto)>> : std::true_type {};
+} // namespace detail
+
+/**
+ * @brief Affine point with coordinates from field backend
+ */
+template <typename Element>
+struct BasicPoint {
+    Element x;
+    Element y;
+    bool is_neutral = false;
+
+    friend bool operator==(const BasicPoint& left, const BasicPoint& right) {
+        if (left.is_neutral || right.is_neutral) {
+            return left.is_neutral == right.is_neutral;
+        }
+        return (left.x == right.x) && (left.y == right.y);
+    }
+
+    friend bool operator!=(const BasicPoint& left, const BasicPoint& right) {
+        return !(left == right);
+    }
+};
+
+/**
+ * @brief Group law of y^2 = x^3 + a*x + b written once for any field backend,
+ *        so the same code runs over BigNum, fixed width or machine word elements
+ */
+template <typename FieldT>
+class BasicEllipticCurve
+{
+public:
+    using Element = typename FieldT::Element;
+    using PointType = BasicPoint<Element>;
+
+    BasicEllipticCurve() = default;
+
+    BasicEllipticCurve(const FieldT& field, const BigNum& a, const BigNum& b)
+        : _field(field)
+        , _a(field.fromBigNum(a))
+        , _b(field.fromBigNum(b))
+    { }
+
+    const FieldT& field() const noexcept {
+        return _field;
+    }
+
+    PointType neutral() const {
+        return {_field.zero(), _field.zero(), true};
+    }
+
+    PointType makePoint(const BigNum& x, const BigNum& y) const {
+        return {_field.fromBigNum(x), _field.fromBigNum(y), false};
+    }
+
+    /**
+     * @return Coordinates of point as BigNum
+     */
+    std::pair<BigNum, BigNum> coordinates(const PointType& p) const {
+        return {_field.toBigNum(p.x), _field.toBigNum(p.y)};
+    }
+
+    bool contains(const PointType& p) const {
+        if (p.is_neutral) {
+            return true;
+        }
+
+        /// y^2 == x^3 + A*x + B
+        const auto right = _field.add(_field.mul(_field.add(_field.sqr(p.x), _a), p.x), _b);
+        return _field.sqr(p.y) == right;
+    }
+
+    PointType invertedPoint(const PointType& p) const {
+        if (p.is_neutral) {
+            return p;
+        }
+        return {p.x, _field.sub(_field.zero(), p.y), false};
+    }
+
+    /**
+     * @brief Temporaries of addPointsInto(), their storage is reused between additions
+     */
+    struct Workspace {
+        Element m;
+        Element numerator;
+        Element denominator;
+        Element inverse;
+        Element x3;
+        Element y3;
+    };
+
+    PointType addPoints(const PointType& first, const PointType& second) const {
+        PointType result = neutral();
+        Workspace ws;
+        addPointsInto(result, first, second, ws);
+        return result;
+    }
+
+    /**
+     * @brief Writes first + second into out, which may alias either point
+     */
+    void addPointsInto(PointType& out, const PointType& first, const PointType& second, Workspace& ws) const {
+        if (first.is_neutral || second.is_neutral) {
+            const auto& other = first.is_neutral ? second : first;
+            if (&out != &other) {
+                out = other;
+            }
+            return;
+        }
+
+        if (first.x != second.x) {
+            ///(y2 - y1)/(x2 - x1)
+            _sub(ws.numerator, second.y, first.y);
+            _sub(ws.denominator, second.x, first.x);
+        } else if (first.y != second.y || first.y == _field.zero()) {
+            out.is_neutral = true;
+            return;
+        } else {
+            ///(3*x1^2 + A)/(2*y1)
+            _sqr(ws.x3, first.x);
+            _add(ws.y3, ws.x3, ws.x3);
+            _add(ws.m, ws.y3, ws.x3);
+            _add(ws.numerator, ws.m, _a);
+            _add(ws.denominator, first.y, first.y);
+        }
+        _inverse(ws.inverse, ws.denominator);
+        _mul(ws.m, ws.numerator, ws.inverse);
+
+        ///x3 = m^2 - x1 - x2
+        _sqr(ws.numerator, ws.m);
+        _sub(ws.denominator, ws.numerator, first.x);
+        _sub(ws.x3, ws.denominator, second.x);
+        ///y3 = m*(x1 - x3) - y1
+        _sub(ws.numerator, first.x, ws.x3);
+        _mul(ws.denominator, ws.m, ws.numerator);
+        _sub(ws.y3, ws.denominator, first.y);
+
+        /// Old coordinates of out go back to workspace, so no storage is freed
+        using std::swap;
+        swap(out.x, ws.x3);
+        swap(out.y, ws.y3);
+        out.is_neutral = false;
+    }
+
+    /**
+     * @brief Adds @a addend to each of @a count points with a single field inversion by Montgomery's trick
+     * @note Points with the same x as addend and neutral points go through addPoints()
+     */
+    std::vector<PointType> addPointsBatch(const PointType* points, std::size_t count, const PointType& addend) const {
+        std::vector<PointType> result(points, points + count);
+        if (addend.is_neutral) {
+            return result;
+        }
+
+        const auto isGeneric = [&addend](const PointType& p) {
+            return !p.is_neutral && p.x != addend.x;
+        };
+
+        /// prefix[i] is product of denominators x2 - x1 of generic points before i
+        std::vector<Element> prefix;
+        prefix.reserve(count + 1);
+        prefix.push_back(_field.one());
+        for (std::size_t i = 0; i < count; i++) {
+            prefix.push_back(isGeneric(points[i]) ? _field.mul(prefix.back(), _field.sub(addend.x, points[i].x))
+                                                  : prefix.back());
+        }
+
+        /// inverse is 1 / prefix[i + 1] on every step, so inverse * prefix[i] is 1 / (x2 - x1) for point i
+        auto inverse = _field.inverse(prefix.back());
+        for (std::size_t i = count; i-- > 0;) {
+            const auto& first = points[i];
+            if (!isGeneric(first)) {
+                result[i] = addPoints(first, addend);
+                continue;
+            }
+
+            const auto denominator = _field.sub(addend.x, first.x);
+            const auto m = _field.mul(_field.sub(addend.y, first.y), _field.mul(inverse, prefix[i]));
+            inverse = _field.mul(inverse, denominator);
+
+            const auto x3 = _field.sub(_field.sub(_field.sqr(m), first.x), addend.x);
+            const auto y3 = _field.sub(_field.mul(m, _field.sub(first.x, x3)), first.y);
+            result[i] = {x3, y3, false};
+        }
+        return result;
+    }
+
+    /**
+     * @brief Double-and-add over binary digits of power
+     */
+    PointType powerPoint(const PointType& p, const BigNum& power) const {
+        const auto words = toWords(power);
+        PointType result = neutral();
+        Workspace ws;
+        for (std::size_t bit = words.size() * 64; bit-- > 0;) {
+            addPointsInto(result, result, result, ws);
+            if ((words[bit / 64] >> (bit % 64)) & 1) {
+                addPointsInto(result, result, p, ws);
+            }
+        }
+        return result;
+    }
+
+private:
+    /**
+     * @brief Field operations into reused outputs, value operations are used when backend has no out-parameter ones
+     */
+    void _add(Element& out, const Element& left, const Element& right) const {
+        if constexpr (detail::HasInPlaceOps<FieldT>::value) {
+            _field.addInto(out, left, right);
+        } else {
+            out = _field.add(left, right);
+        }
+    }
+
+    void _sub(Element& out, const Element& left, const Element& right) const {
+        if constexpr (detail::HasInPlaceOps<FieldT>::value) {
+            _field.subInto(out, left, right);
+        } else {
+            out = _field.sub(left, right);
+        }
+    }
+
+    void _mul(Element& out, const Element& left, const Element& right) const {
+        if constexpr (detail::HasInPlaceOps<FieldT>::value) {
+            _field.mulInto(out, left, right);
+        } else {
+            out = _field.mul(left, right);
+        }
+    }
+
+    void _sqr(Element& out, const Element& num) const {
+        if constexpr (detail::HasInPlaceOps<FieldT>::value) {
+            _field.sqrInto(out, num);
+        } else {
+            out = _field.sqr(num);
+        }
+    }
+
+    void _inverse(Element& out, const Element& num) const {
+        if constexpr (detail::HasInPlaceOps<FieldT>::value) {
+            _field.inverseInto(out, num);
+        } else {
+            out = _field.inverse(num);
+        }
+    }
+
+    FieldT _field;
+    Element _a;
+    Element _b;
+};
+
+} // namespace lab
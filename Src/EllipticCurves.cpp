@@ -1,8 +1,121 @@
 #include <EllipticCurves.hpp>
+#include <BigInt.hpp>
+
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
 
 namespace lab {
 
-EllipticCurve::EllipticCurve(Field* f, const BigNum& a, const BigNum& b): _f(f),_a(a),_b(b){}
+namespace {
+    /**
+     * @brief Field modulo limit of pointOrder(): 2^20 baby steps and as many giant steps, and factorization()
+     *        of a multiple of order below 2^81 take seconds, while each 8 more bits double the steps
+     */
+    constexpr std::size_t MAX_ORDER_SEARCH_BITS = 80;
+
+    template <typename Curve>
+    typename Curve::PointType toEngine(const Curve& curve, const Point& p) {
+        if (p == EllipticCurve::neutral) {
+            return curve.neutral();
+        }
+        return curve.makePoint(p.x, p.y);
+    }
+
+    template <typename Curve>
+    Point fromEngine(const Curve& curve, const typename Curve::PointType& p) {
+        if (p.is_neutral) {
+            return EllipticCurve::neutral;
+        }
+        const auto& [x, y] = curve.coordinates(p);
+        return {x, y};
+    }
+
+    /**
+     * @brief Baby-step giant-step over Hasse interval: with m = [q^(1/4)] + 1 finds k in [-m, m] and j in [0, m]
+     *        such that (q + 1 + 2mk) * P = +-j * P, since order of curve is q + 1 - t with |t| <= 2 * sqrt(q)
+     * @return Positive multiple of order of p, nothing if no match was found
+     * @note Baby steps are keyed by x, so one lookup covers both j * P and -j * P
+     * @throw std::invalid_argument if q has more than MAX_ORDER_SEARCH_BITS bits
+     */
+    template <typename Curve>
+    std::optional<BigNum> multipleOfOrder(const Curve& curve, const typename Curve::PointType& p, const BigNum& q) {
+        using PointType = typename Curve::PointType;
+        if (p.is_neutral) {
+            return 1_bn;
+        }
+
+        if (bitLength(q) > MAX_ORDER_SEARCH_BITS) {
+            throw std::invalid_argument("Point order search supports field modulo of at most 80 bits");
+        }
+
+        /// m <= 2^20 + 1
+        const BigNum m = root(q, 4) + 1;
+        const auto count = static_cast<std::size_t>(lowBits(m, 64));
+
+        /// Baby steps j * P for j = 1 .. m. Every round adds k * P to the first k steps, so they share one inversion
+        std::vector<PointType> baby_steps{p};
+        baby_steps.reserve(count);
+        while (baby_steps.size() < count) {
+            const std::size_t round = std::min(baby_steps.size(), count - baby_steps.size());
+            const auto next = curve.addPointsBatch(baby_steps.data(), round, baby_steps.back());
+            baby_steps.insert(baby_steps.end(), next.begin(), next.end());
+        }
+
+        std::unordered_map<BigNum, std::size_t> indices;
+        indices.reserve(count);
+        for (std::size_t i = 0; i < count; i++) {
+            if (baby_steps[i].is_neutral) {
+                /// Order is at most m
+                return BigNum(static_cast<uint64_t>(i + 1));
+            }
+            indices.emplace(curve.field().toBigNum(baby_steps[i].x), i);
+        }
+
+        /// Giant steps Q + k * S for Q = (q + 1) * P and S = 2m * P, each of them is one addition of S
+        const BigInt bound(m);
+        const BigInt two_m(2_bn * m);
+        const BigInt q_plus_one(q + 1);
+        const auto step = curve.powerPoint(p, 2_bn * m);
+        auto giant = curve.addPoints(curve.powerPoint(p, q + 1), curve.invertedPoint(curve.powerPoint(step, m)));
+        for (BigInt k = -bound; k <= bound; k += 1) {
+            const BigInt shift = q_plus_one + two_m * k;
+            if (giant.is_neutral && shift.sign() > 0) {
+                return shift.magnitude();
+            }
+
+            if (!giant.is_neutral) {
+                const auto found = indices.find(curve.field().toBigNum(giant.x));
+                if (found != indices.end()) {
+                    /// Q + k * S = j * P gives (shift - j) * P = neutral, Q + k * S = -j * P gives (shift + j) * P = neutral
+                    const BigInt index(BigNum(static_cast<uint64_t>(found->second + 1)));
+                    const auto multiple = giant.y == baby_steps[found->second].y ? shift - index : shift + index;
+                    if (multiple.sign() > 0) {
+                        return multiple.magnitude();
+                    }
+                }
+            }
+            giant = curve.addPoints(giant, step);
+        }
+        return {};
+    }
+} // namespace
+
+EllipticCurve::EllipticCurve(Field* f, const BigNum& a, const BigNum& b): _f(f),_a(a),_b(b){
+    const std::size_t bits = bitLength(f->modulo);
+    const bool odd = isOdd(f->modulo);
+    if (odd && bits <= ModInt64Field::MAX_BITS) {
+        _engine.emplace<BasicEllipticCurve<ModInt64Field>>(ModInt64Field(f->modulo), a, b);
+    } else if (odd && bits <= 256) {
+        _engine.emplace<BasicEllipticCurve<FixedField<256>>>(FixedField<256>(f->modulo), a, b);
+    } else if (odd && bits <= 384) {
+        _engine.emplace<BasicEllipticCurve<FixedField<384>>>(FixedField<384>(f->modulo), a, b);
+    } else if (odd && bits <= 521) {
+        _engine.emplace<BasicEllipticCurve<FixedField<521>>>(FixedField<521>(f->modulo), a, b);
+    } else {
+        _engine.emplace<BasicEllipticCurve<BigNumField>>(BigNumField(f->reducer), a, b);
+    }
+}
 
 bool operator==(const EllipticCurve& left, const EllipticCurve& right) {
     return (*left._f == *right._f) && (left._a == right._a) && (left._b == right._b);
@@ -13,78 +126,21 @@ bool operator!=(const EllipticCurve& left, const EllipticCurve& right) {
 }
 
 bool EllipticCurve::contains(const Point& p) const {
-    if (p == neutral)
-        return true;
-
-    /// y^2 == x^3 + A*x + B
-    if ((p.y * p.y) % _f->modulo == ((p.x * p.x * p.x + _a * p.x + _b) % _f->modulo))
-       return true;
-    else
-       return false;
- }
+    return std::visit([&p](const auto& curve) {
+        return curve.contains(toEngine(curve, p));
+    }, _engine);
+}
 
 Point EllipticCurve::invertedPoint(const Point& p) const {
-    if (p == neutral)
-        return neutral;
-    return { p.x, subtract(_f->modulo, p.y,_f->modulo) };
+    return std::visit([&p](const auto& curve) {
+        return fromEngine(curve, curve.invertedPoint(toEngine(curve, p)));
+    }, _engine);
 }
 
 Point EllipticCurve::addPoints(const Point& first, const Point& second) const {
-    if ((first == neutral) || (second == neutral))
-        return first == neutral ? second : first;
-
-    if ((first.x == second.x && first.y != second.y)
-        || (first == second && first.y == 0_bn))
-    {
-        return neutral;
-    } else {
-        BigNum tmp1;
-        BigNum tmp2;
-        BigNum m;
-        if (first.x != second.x) {
-            ///y2-y1
-            tmp1 = subtract(second.y, first.y, _f->modulo);
-
-            ///x2-x1
-            tmp2 = subtract(second.x, first.x, _f->modulo);
-        } else {
-            ///x1^2
-            tmp1 = powMontgomery(first.x, 2_bn, _f->modulo);
-            
-            ///3*x1^2
-            tmp1 = multiply(3_bn, tmp1, _f->modulo);
-            
-            ///3*x1^2 + A
-            tmp1 = add(tmp1, _a, _f->modulo);
-            
-            ///2*y1
-            tmp2 = multiply(2_bn, first.y, _f->modulo);
-        }
-        
-        ///(y2 - y1)/(x2 - x1) or (3*x1^2 + A)/(2*y1)
-        m = multiply(tmp1, inverted(tmp2, _f->modulo, BigNum::InversionPolicy::Fermat), _f->modulo);
-
-        ///m^2
-        tmp1 = multiply(m, m, _f->modulo); 
-
-        ///x1 + x2
-        tmp2 = add(first.x, second.x, _f->modulo); 
-		
-        ///x3 = m^2 - x1 - x2
-        tmp1 = subtract(tmp1, tmp2, _f->modulo); 
-
-        ///x1 - x3
-        tmp2 = subtract(first.x, tmp1, _f->modulo); 			
-
-        ///m*(x1 - x3)
-        tmp2 = multiply(m, tmp2, _f->modulo); 
-        
-        ///y3 = m*(x1 - x3) - y1
-        tmp2 = subtract(tmp2, first.y, _f->modulo); 
-
-        ///{x3,y3} - answer
-        return{ tmp1,tmp2 };
-    }
+    return std::visit([&first, &second](const auto& curve) {
+        return fromEngine(curve, curve.addPoints(toEngine(curve, first), toEngine(curve, second)));
+    }, _engine);
 }
 
 /**
@@ -92,115 +148,42 @@ Point EllipticCurve::addPoints(const Point& first, const Point& second) const {
  */
 
     Point EllipticCurve::powerPoint(const Point& point, const BigNum& a) const {
-        if (a == 0_bn){
-            return neutral;
-        }
-        if (a == 1_bn){
-            return point;
-        }
-        std::pair<BigNum, BigNum> divMod = extract(a, 2_bn);
-        Point squared = powerPoint(point,divMod.first); // let squared be point^(a/2)
-        if(divMod.second == 0_bn) { // checking if a % 2 == 0
-            return addPoints(squared,squared);
-
-        } else {
-            return addPoints(addPoints(squared,squared),point);
-        }
+        return std::visit([&point, &a](const auto& curve) {
+            return fromEngine(curve, curve.powerPoint(toEngine(curve, point), a));
+        }, _engine);
     }
 
     BigNum EllipticCurve::getFieldModulo() const{
         return _f->modulo;
     }
 
-    BigNum EllipticCurve::pointOrder(const Point& p) const {
-
-        // Calculate Q = (q + 1) * p
-
-        Point Q = powerPoint(p, _f->modulo + 1_bn);
-
-        BigNum q_sqrt = sqrt(_f->modulo);
-        BigNum m = sqrt(q_sqrt) + 1_bn;
-
-        std::vector<Point> calculated_points;
-
-        // Calculate and store points i * p for i = 1 .. m, where m = [modulo ^ (1/4)]
-
-        Point point = p;
-        for (BigNum i = 1_bn; i <= m; i = i + 1_bn){
-            calculated_points.push_back(point);
-            point = addPoints(point, p);
-        }
-
-        bool negative = true;
-        point = powerPoint(p, 2_bn * m);
-        Point right_part(0_bn, 0_bn);
-        BigNum k = m;
-
-
-        // calculate new point: result = Q + right_part
-        // where right_part = k * (2 * m * p)
-        // for k = -m, - m + 1, ..., -1, 0, 1, ..., m - 1, m
-
-        while (true){
-
-            if (k == 0_bn) negative = false;
-
-            if (negative){
-                right_part = invertedPoint(powerPoint(point, k));
-            } else {
-                right_part = powerPoint(point, k);
-            }
-
-            Point result = addPoints(Q, right_part);
-
-            // check if calculated point result is equal to saved point or ist inverted
-            // (result i * p or - i * p)
-            // if yes then Q + k * (2 * m * p) = (+-) i * p, hence (while Q = (modulo + 1) * p)
-            // ( modulo + 1 + k * (2 * m) (-+) i ) * p = neutral
-            // so we get that order is divisor of M = modulo + 1 + k * (2 * m) (-+) i
-
-            BigNum index = 1_bn;
-            for (const auto& i : calculated_points){
-
-                if (result == i){
-                    BigNum M = negative ? (_f->modulo + 1_bn - 2_bn * m * k - index) :
-                                    (_f->modulo + 1_bn + 2_bn * m * k - index);
-                    M = M % _f->modulo;
-                    return reduce(M, p); // return function which finds divisor which is order
-                } else if (result == invertedPoint(i)){
-                    BigNum M = negative ? (_f->modulo + 1_bn - 2_bn * m * k + index ) :
-                        (_f->modulo + 1_bn + 2_bn * m * k + index);
-                    M = M % _f->modulo;
-                    return reduce(M, p); // return function which finds divisor which is order
-                }
-
-                index = index + 1_bn;
-            }
-
-            if (negative){
-                k = k - 1_bn;
-                if (k == 0_bn) negative = false;
-            } else {
-                k = k + 1_bn;
-            }
+    CurveBackend EllipticCurve::backend() const {
+        return static_cast<CurveBackend>(_engine.index());
+    }
 
-            if (k >= m + 1_bn){
-                break;
-            }
+    BigNum EllipticCurve::pointOrder(const Point& p) const {
+        const auto multiple = std::visit([this, &p](const auto& curve) {
+            return multipleOfOrder(curve, toEngine(curve, p), _f->modulo);
+        }, _engine);
+        if (multiple) {
+            BigNum M = *multiple;
+            return reduce(M, p); // return function which finds divisor which is order
         }
 
+        // walk through the whole Hasse interval if baby-step giant-step found nothing
 
-        BigNum left = _f->modulo + 1_bn - 2_bn * q_sqrt;
-        BigNum right = _f->modulo + 1_bn + 2_bn * q_sqrt;
-        point = powerPoint(p, left);
-        for (BigNum i = left; i <= right; i = i + 1_bn){
+        BigNum q_sqrt = sqrt(_f->modulo);
+        BigNum left = _f->modulo + 1 - 2_bn * q_sqrt;
+        BigNum right = _f->modulo + 1 + 2_bn * q_sqrt;
+        Point point = powerPoint(p, left);
+        for (BigNum i = left; i <= right; i += 1){
             if (point == EllipticCurve::neutral){
                 return reduce(i, p);
             }
             point = addPoints(point, p);
         }
 
-        return BigNum("Thank you for your attention!!!)");
+        throw std::invalid_argument("Point order wasn't found in Hasse interval, field modulo must be prime");
     }
 
     BigNum EllipticCurve::reduce(BigNum& M, const Point& p) const {
@@ -211,7 +194,7 @@ Point EllipticCurve::addPoints(const Point& first, const Point& second) const {
             all_not_infinity = false;
             for (auto& div : divisors){
                 if (div.second > 0_bn && powerPoint(p, M/div.first) == neutral){
-                    div.second = div.second - 1_bn;
+                    div.second = div.second - 1;
                     all_not_infinity = true;
                     M = M/div.first;
                 } else div.second = 0_bn;
@@ -222,22 +205,111 @@ Point EllipticCurve::addPoints(const Point& first, const Point& second) const {
     }
 
     BigNum EllipticCurve::countPoints() const {
-        BigNum left = _f->modulo + 1_bn - 2_bn * sqrt(_f->modulo);
-        BigNum right = _f->modulo + 1_bn + 2_bn * sqrt(_f->modulo);
+        const BigNum q_sqrt = sqrt(_f->modulo);
+        BigNum left = _f->modulo + 1 - 2_bn * q_sqrt;
+        BigNum right = _f->modulo + 1 + 2_bn * q_sqrt;
         BigNum lcm = 1_bn;
         BigNum x = 1_bn;
+        const auto rightSide = [this](const BigNum& x) {
+            return (x * x * x + x * _a + _b) % _f->modulo;
+        };
         while (!(left <= lcm && lcm <= right)){
-            while (!sqrt(x * x * x + x * _a + _b, _f->modulo) ||
-                   !contains(Point(x, sqrt(x * x * x + x * _a + _b, _f->modulo)->second))){
-                x = x + 1_bn;
+            /// Jacobi symbol skips x without points, the root is taken once for the x found,
+            /// it is defined for odd modulo only, so even one is left to the root
+            auto right_side = rightSide(x);
+            while (isOdd(_f->modulo) && jacobi(right_side, _f->modulo) == -1) {
+                x += 1;
+                right_side = rightSide(x);
             }
-            Point point = Point(x, sqrt(x * x * x + x * _a + _b, _f->modulo)->second);
-            if (contains(point)) {
-                BigNum point_order = pointOrder(point);
+            const auto roots = sqrt(right_side, _f->modulo);
+            if (roots && contains(Point(x, roots->second))) {
+                BigNum point_order = pointOrder(Point(x, roots->second));
                 lcm = point_order * lcm / gcd(point_order, lcm);
             }
-            x = x + 1_bn;
+            x += 1;
         }
         return lcm;
     }
-}
\ No newline at end of file
+
+    std::size_t EllipticCurve::encodedSize(PointFormat format) const {
+        const std::size_t width = byteLength(_f->modulo);
+        return format == PointFormat::Compressed ? 1 + width : 1 + 2 * width;
+    }
+
+    std::vector<std::byte> EllipticCurve::encodePoint(const Point& p, PointFormat format) const {
+        if (p == neutral) {
+            return {std::byte{0x00}};
+        }
+
+        const std::size_t width = byteLength(_f->modulo);
+        std::vector<std::byte> result(encodedSize(format));
+        if (format == PointFormat::Compressed) {
+            result[0] = isOdd(p.y) ? std::byte{0x03} : std::byte{0x02};
+        } else {
+            result[0] = std::byte{0x04};
+            toBytes(p.y, result.data() + 1 + width, width, Endian::Big);
+        }
+        toBytes(p.x, result.data() + 1, width, Endian::Big);
+        return result;
+    }
+
+    Point EllipticCurve::decodePoint(const std::byte* data, std::size_t size) const {
+        if (size == 1 && data[0] == std::byte{0x00}) {
+            return neutral;
+        }
+
+        const std::size_t width = byteLength(_f->modulo);
+        const bool compressed = size == encodedSize(PointFormat::Compressed)
+                                && (data[0] == std::byte{0x02} || data[0] == std::byte{0x03});
+        const bool uncompressed = size == encodedSize(PointFormat::Uncompressed) && data[0] == std::byte{0x04};
+        if (!compressed && !uncompressed) {
+            throw std::invalid_argument("Malformed point encoding");
+        }
+
+        const BigNum x = fromBytes(data + 1, width, Endian::Big);
+        if (compressed) {
+            return decompress(x, data[0] == std::byte{0x03});
+        }
+
+        const Point result(x, fromBytes(data + 1 + width, width, Endian::Big));
+        if (result.x >= _f->modulo || result.y >= _f->modulo || !contains(result)) {
+            throw std::invalid_argument("Point doesn't belong to curve");
+        }
+        return result;
+    }
+
+    std::vector<Point> EllipticCurve::decodePoints(const std::byte* data, std::size_t count, PointFormat format) const {
+        const std::size_t size = encodedSize(format);
+        std::vector<Point> result;
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::byte prefix = data[i * size];
+            if ((prefix == std::byte{0x04}) != (format == PointFormat::Uncompressed)) {
+                throw std::invalid_argument("Malformed point encoding");
+            }
+            result.push_back(decodePoint(data + i * size, size));
+        }
+        return result;
+    }
+
+    Point EllipticCurve::decompress(const BigNum& x, bool odd_y) const {
+        const auto& ctx = _f->reducer;
+        if (x >= _f->modulo) {
+            throw std::invalid_argument("Point doesn't belong to curve");
+        }
+
+        /// y^2 = (x^2 + a) * x + b
+        const auto right = add(multiply(add(multiply(x, x, ctx), _a, ctx), x, ctx), _b, ctx);
+        const auto roots = sqrt(right, ctx);
+        if (!roots) {
+            throw std::invalid_argument("Point doesn't belong to curve");
+        }
+        if (isOdd(roots->first) == odd_y) {
+            return {x, roots->first};
+        }
+        if (roots->first == 0) {
+            throw std::invalid_argument("Point doesn't belong to curve");
+        }
+        return {x, roots->second};
+    }
+}
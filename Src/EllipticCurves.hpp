@@ -1,6 +1,12 @@
 #pragma once
 
 #include "BigNum.hpp"
+#include "Modulus.hpp"
+#include "CurveEngine.hpp"
+#include "FixedBigNum.hpp"
+#include "ModInt.hpp"
+#include <cstddef>
+#include <variant>
 #include <vector>
 
 
@@ -16,15 +22,53 @@ struct Point {
     }
 };
 
+/**
+ * @brief Hash of both coordinates, so points can be keys of unordered containers
+ */
+inline std::size_t hash(const Point& p) noexcept {
+    /// Rotation keeps (x, y) and (y, x) apart
+    const std::size_t hash_y = hash(p.y);
+    return hash(p.x) ^ ((hash_y << 17) | (hash_y >> (sizeof(std::size_t) * 8 - 17)));
+}
+
 struct Field {
     BigNum modulo;
-    Field(const BigNum& g) :modulo(g) {}
+    /// Reduction context for modulo, shared by all arithmetic on the field
+    Modulus reducer;
+    Field(const BigNum& g) :modulo(g), reducer(g) {}
+    Field(const BigNum& g, ModulusForm form) :modulo(g), reducer(g, form) {}
 
     friend bool operator==(const Field& left, const Field& right) {
         return left.modulo == right.modulo;
     }
 };
 
+/**
+ * @brief Field arithmetic used by EllipticCurve, picked by size of modulo when curve is constructed
+ */
+enum class CurveBackend {
+    /// Odd modulo below 2^63, computed in machine registers
+    MachineWord,
+    /// Odd modulo up to 256 bits
+    Fixed256,
+    /// Odd modulo up to 384 bits
+    Fixed384,
+    /// Odd modulo up to 521 bits
+    Fixed521,
+    /// Any other modulo, computed over BigNum
+    Generic
+};
+
+/**
+ * @brief SEC1 point encodings, coordinates are big-endian and padded to byte length of field modulo
+ */
+enum class PointFormat {
+    /// 0x02 for even y or 0x03 for odd y, then x
+    Compressed,
+    /// 0x04, then x and y
+    Uncompressed
+};
+
 class EllipticCurve {
 public:
     EllipticCurve(const EllipticCurve& that) = default;
@@ -63,14 +107,44 @@ public:
 
     BigNum getFieldModulo() const;
 
-    ///< y^2 = x^3 + a*x + b on field f
+    /**
+    * @return Field arithmetic picked for this curve
+    */
+    CurveBackend backend() const;
+
+    /**
+    * @brief Order of point by baby-step giant-step over Hasse interval
+    * @note About 2^20 baby and giant steps at the limit, time and memory grow as q^(1/4)
+    * @throw std::invalid_argument if field modulo has more than 80 bits
+    * @throw std::invalid_argument if no multiple of order lies in Hasse interval, which means field modulo isn't prime
+    */
     BigNum pointOrder(const Point& p) const;
 
     /**
     * @return count of points on curve
+    * @throw std::invalid_argument if point order search fails, which means field modulo isn't prime
     */
     BigNum countPoints() const;
 
+    /**
+    * @return Count of bytes in encoding of point other than neutral, which is a single zero byte
+    */
+    std::size_t encodedSize(PointFormat format) const;
+
+    std::vector<std::byte> encodePoint(const Point& p, PointFormat format) const;
+
+    /**
+    * @brief Restores point from any SEC1 encoding, y of compressed point is a square root modulo field modulo
+    * @throw std::invalid_argument if encoding is malformed or point doesn't belong to curve
+    */
+    Point decodePoint(const std::byte* data, std::size_t size) const;
+
+    /**
+    * @brief Decodes @a count points of one format stored back to back, all of them share reduction context of field
+    * @throw std::invalid_argument if any encoding is malformed, neutral point can't be stored this way
+    */
+    std::vector<Point> decodePoints(const std::byte* data, std::size_t count, PointFormat format) const;
+
 private:
 
     /**
@@ -78,10 +152,25 @@ private:
      * */
     BigNum reduce(BigNum& num, const Point& p) const;
 
+    /**
+     * @brief Finds y of point with given x and parity of y
+     */
+    Point decompress(const BigNum& x, bool odd_y) const;
+
+    /// Alternatives are listed in order of CurveBackend
+    using Engine = std::variant<BasicEllipticCurve<ModInt64Field>,
+                                BasicEllipticCurve<FixedField<256>>,
+                                BasicEllipticCurve<FixedField<384>>,
+                                BasicEllipticCurve<FixedField<521>>,
+                                BasicEllipticCurve<BigNumField>>;
+
     /// y^2 = x^3 + a*x + b on field f
     Field* _f;
     BigNum _a;
     BigNum _b;
+
+    /// Same curve over field backend matching size of modulo, every group operation is dispatched to it
+    Engine _engine;
 };
 
 template<typename OStream>
@@ -91,3 +180,12 @@ OStream& operator<<(OStream& os, const EllipticCurve& curve) {
 }
 
 } // namespace lab
+
+namespace std {
+template <>
+struct hash<lab::Point> {
+    std::size_t operator()(const lab::Point& p) const noexcept {
+        return lab::hash(p);
+    }
+};
+} // namespace std
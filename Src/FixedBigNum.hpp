@@ -0,0 +1,523 @@
+#pragma once
+
+#include "BigNum.hpp"
+#include "Modulus.hpp"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace lab {
+
+namespace detail {
+    template <typename F, std::size_t... I>
+    constexpr void unrollImpl(F&& f, std::index_sequence<I...>) {
+        (f(std::integral_constant<std::size_t, I>{}), ...);
+    }
+
+    /**
+     * @brief Calls f(0), f(1), ..., f(N - 1) without a loop
+     */
+    template <std::size_t N, typename F>
+    constexpr void unroll(F&& f) {
+        unrollImpl(f, std::make_index_sequence<N>{});
+    }
+} // namespace detail
+
+/**
+ * @brief Unsigned integer of fixed width stored on stack as 64-bit words,
+ *        arithmetic wraps modulo 2^(64 * LIMBS) and never allocates
+ */
+template <std::size_t Bits>
+class FixedBigNum
+{
+public:
+    static_assert(Bits > 0, "FixedBigNum must hold at least one bit");
+
+    static constexpr std::size_t LIMBS = (Bits + 63) / 64;
+    static constexpr std::size_t WORD_BITS = 64;
+
+    constexpr FixedBigNum() = default;
+
+    constexpr explicit FixedBigNum(uint64_t value) {
+        _limbs[0] = value;
+    }
+
+    constexpr explicit FixedBigNum(const std::array<uint64_t, LIMBS>& limbs)
+        : _limbs(limbs)
+    { }
+
+    /**
+     * @brief Widening conversion, so narrow literals initialize wider numbers
+     */
+    template <std::size_t OtherBits, typename = std::enable_if_t<(OtherBits < Bits)>>
+    constexpr FixedBigNum(const FixedBigNum<OtherBits>& num) noexcept {
+        for (std::size_t i = 0; i < FixedBigNum<OtherBits>::LIMBS; ++i) {
+            _limbs[i] = num[i];
+        }
+    }
+
+    /**
+     * @throw std::invalid_argument if num doesn't fit into Bits
+     */
+    explicit FixedBigNum(const BigNum& num) {
+        const auto words = toWords(num);
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            if (i >= LIMBS) {
+                if (words[i] != 0) {
+                    throw std::invalid_argument("Number doesn't fit into FixedBigNum");
+                }
+                continue;
+            }
+            _limbs[i] = words[i];
+        }
+        if (bitLength() > Bits) {
+            throw std::invalid_argument("Number doesn't fit into FixedBigNum");
+        }
+    }
+
+    explicit operator BigNum() const {
+        return fromWords(std::vector<uint64_t>(_limbs.begin(), _limbs.end()));
+    }
+
+    constexpr uint64_t operator[](std::size_t i) const noexcept {
+        return _limbs[i];
+    }
+
+    constexpr uint64_t& operator[](std::size_t i) noexcept {
+        return _limbs[i];
+    }
+
+    constexpr const std::array<uint64_t, LIMBS>& limbs() const noexcept {
+        return _limbs;
+    }
+
+    constexpr bool isZero() const noexcept {
+        bool result = true;
+        detail::unroll<LIMBS>([&](auto i) { result = result && (_limbs[i] == 0); });
+        return result;
+    }
+
+    constexpr bool testBit(std::size_t bit) const noexcept {
+        return bit < LIMBS * WORD_BITS && ((_limbs[bit / WORD_BITS] >> (bit % WORD_BITS)) & 1) != 0;
+    }
+
+    constexpr std::size_t bitLength() const noexcept {
+        for (std::size_t i = LIMBS; i > 0; --i) {
+            if (_limbs[i - 1] != 0) {
+                std::size_t bits = (i - 1) * WORD_BITS;
+                for (uint64_t word = _limbs[i - 1]; word != 0; word >>= 1) {
+                    ++bits;
+                }
+                return bits;
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * @brief out = left + right
+     * @return Carry out of the highest word
+     */
+    static constexpr uint64_t addWithCarry(FixedBigNum& out, const FixedBigNum& left, const FixedBigNum& right) noexcept {
+        uint64_t carry = 0;
+        detail::unroll<LIMBS>([&](auto i) {
+            const unsigned __int128 sum = static_cast<unsigned __int128>(left._limbs[i]) + right._limbs[i] + carry;
+            out._limbs[i] = static_cast<uint64_t>(sum);
+            carry = static_cast<uint64_t>(sum >> WORD_BITS);
+        });
+        return carry;
+    }
+
+    /**
+     * @brief out = left - right
+     * @return Borrow out of the highest word
+     */
+    static constexpr uint64_t subtractWithBorrow(FixedBigNum& out, const FixedBigNum& left, const FixedBigNum& right) noexcept {
+        uint64_t borrow = 0;
+        detail::unroll<LIMBS>([&](auto i) {
+            const unsigned __int128 difference = static_cast<unsigned __int128>(left._limbs[i]) - right._limbs[i] - borrow;
+            out._limbs[i] = static_cast<uint64_t>(difference);
+            borrow = static_cast<uint64_t>(difference >> WORD_BITS) & 1;
+        });
+        return borrow;
+    }
+
+    /**
+     * @return Full product of left and right without wrapping
+     */
+    static constexpr FixedBigNum<LIMBS * 2 * WORD_BITS> multiplyWide(const FixedBigNum& left, const FixedBigNum& right) noexcept {
+        FixedBigNum<LIMBS * 2 * WORD_BITS> result;
+        detail::unroll<LIMBS>([&](auto i) {
+            uint64_t carry = 0;
+            detail::unroll<LIMBS>([&](auto j) {
+                const unsigned __int128 temp = static_cast<unsigned __int128>(left._limbs[i]) * right._limbs[j]
+                                             + result[i + j] + carry;
+                result[i + j] = static_cast<uint64_t>(temp);
+                carry = static_cast<uint64_t>(temp >> WORD_BITS);
+            });
+            result[i + LIMBS] = carry;
+        });
+        return result;
+    }
+
+    friend constexpr FixedBigNum operator+(const FixedBigNum& left, const FixedBigNum& right) noexcept {
+        FixedBigNum result;
+        addWithCarry(result, left, right);
+        return result;
+    }
+
+    friend constexpr FixedBigNum operator-(const FixedBigNum& left, const FixedBigNum& right) noexcept {
+        FixedBigNum result;
+        subtractWithBorrow(result, left, right);
+        return result;
+    }
+
+    friend constexpr FixedBigNum operator*(const FixedBigNum& left, const FixedBigNum& right) noexcept {
+        const auto wide = multiplyWide(left, right);
+        FixedBigNum result;
+        detail::unroll<LIMBS>([&](auto i) { result._limbs[i] = wide[i]; });
+        return result;
+    }
+
+    friend constexpr FixedBigNum operator<<(const FixedBigNum& num, std::size_t shift) noexcept {
+        FixedBigNum result;
+        const std::size_t word_shift = shift / WORD_BITS;
+        const std::size_t bit_shift = shift % WORD_BITS;
+        for (std::size_t i = LIMBS; i-- > word_shift;) {
+            result._limbs[i] = num._limbs[i - word_shift] << bit_shift;
+            if (bit_shift != 0 && i > word_shift) {
+                result._limbs[i] |= num._limbs[i - word_shift - 1] >> (WORD_BITS - bit_shift);
+            }
+        }
+        return result;
+    }
+
+    friend constexpr FixedBigNum operator>>(const FixedBigNum& num, std::size_t shift) noexcept {
+        FixedBigNum result;
+        const std::size_t word_shift = shift / WORD_BITS;
+        const std::size_t bit_shift = shift % WORD_BITS;
+        for (std::size_t i = 0; i + word_shift < LIMBS; ++i) {
+            result._limbs[i] = num._limbs[i + word_shift] >> bit_shift;
+            if (bit_shift != 0 && i + word_shift + 1 < LIMBS) {
+                result._limbs[i] |= num._limbs[i + word_shift + 1] << (WORD_BITS - bit_shift);
+            }
+        }
+        return result;
+    }
+
+    friend constexpr bool operator==(const FixedBigNum& left, const FixedBigNum& right) noexcept {
+        bool result = true;
+        detail::unroll<LIMBS>([&](auto i) { result = result && (left._limbs[i] == right._limbs[i]); });
+        return result;
+    }
+
+    friend constexpr bool operator!=(const FixedBigNum& left, const FixedBigNum& right) noexcept {
+        return !(left == right);
+    }
+
+    friend constexpr bool operator<(const FixedBigNum& left, const FixedBigNum& right) noexcept {
+        for (std::size_t i = LIMBS; i > 0; --i) {
+            if (left._limbs[i - 1] != right._limbs[i - 1]) {
+                return left._limbs[i - 1] < right._limbs[i - 1];
+            }
+        }
+        return false;
+    }
+
+    friend constexpr bool operator>(const FixedBigNum& left, const FixedBigNum& right) noexcept {
+        return right < left;
+    }
+
+    friend constexpr bool operator<=(const FixedBigNum& left, const FixedBigNum& right) noexcept {
+        return !(right < left);
+    }
+
+    friend constexpr bool operator>=(const FixedBigNum& left, const FixedBigNum& right) noexcept {
+        return !(left < right);
+    }
+
+private:
+    std::array<uint64_t, LIMBS> _limbs{};
+};
+
+namespace detail {
+    /**
+     * @brief Cells of decimal literal converted to 64-bit words at compile time, least significant word first
+     */
+    template <char... Chars>
+    struct FixedLiteral {
+        using Decimal = DecimalLiteral<Chars...>;
+
+        /// Cell is below 2^30, so 30 bits per cell always suffice
+        static constexpr std::size_t MAX_WORDS = (Decimal::SIZE * 30 + 63) / 64;
+
+        static constexpr std::array<uint64_t, MAX_WORDS> convert() {
+            std::array<uint64_t, MAX_WORDS> words{};
+            for (std::size_t cell = Decimal::SIZE; cell-- > 0;) {
+                /// words = words * 10^9 + cell
+                unsigned __int128 carry = static_cast<uint64_t>(Decimal::CELLS[cell]);
+                for (auto& word : words) {
+                    carry += static_cast<unsigned __int128>(word) * CELL_BASE;
+                    word = static_cast<uint64_t>(carry);
+                    carry >>= 64;
+                }
+            }
+            return words;
+        }
+
+        static constexpr std::array<uint64_t, MAX_WORDS> WORDS = convert();
+
+        static constexpr std::size_t bitLength() {
+            for (std::size_t i = MAX_WORDS; i-- > 0;) {
+                if (WORDS[i] != 0) {
+                    std::size_t bits = i * 64;
+                    for (uint64_t word = WORDS[i]; word != 0; word >>= 1) {
+                        ++bits;
+                    }
+                    return bits;
+                }
+            }
+            return 0;
+        }
+
+        /// Zero takes one bit, as FixedBigNum can't be empty
+        static constexpr std::size_t BITS = bitLength() == 0 ? 1 : bitLength();
+
+        static constexpr FixedBigNum<BITS> value() {
+            FixedBigNum<BITS> result;
+            for (std::size_t i = 0; i < FixedBigNum<BITS>::LIMBS; ++i) {
+                result[i] = WORDS[i];
+            }
+            return result;
+        }
+    };
+} // namespace detail
+
+/**
+ * @brief Literal evaluated during compilation into a number as wide as its value, e.g. 234131_fbn is FixedBigNum<18>,
+ *        so constants built from it are constexpr and cost nothing at load, unlike BigNum ones
+ */
+template <char... Chars>
+constexpr FixedBigNum<detail::FixedLiteral<Chars...>::BITS> operator""_fbn() {
+    return detail::FixedLiteral<Chars...>::value();
+}
+
+/**
+ * @brief Prime field over odd modulus of at most Bits bits, elements are FixedBigNum
+ *        kept in Montgomery form x * 2^(64 * LIMBS) mod p. Pseudo-Mersenne modulus 2^n - c
+ *        keeps elements as they are and reduces products by folding 2^n = c instead
+ */
+template <std::size_t Bits>
+class FixedField
+{
+public:
+    using Element = FixedBigNum<Bits>;
+    static constexpr std::size_t LIMBS = Element::LIMBS;
+
+    FixedField() = default;
+
+    /**
+     * @throw std::invalid_argument if mod is even or doesn't fit into Bits
+     */
+    explicit FixedField(const BigNum& mod)
+        : _mod(mod)
+        , _p(mod)
+    {
+        if (_p[0] % 2 == 0) {
+            throw std::invalid_argument("Modulo of FixedField must be odd");
+        }
+
+        const Modulus ctx(mod);
+        _inversion_exponent = ctx.inversionExponent();
+        const uint64_t c = ctx.pseudoMersenneConstant();
+        const std::size_t bits = _p.bitLength();
+        const std::size_t padding = LIMBS * Element::WORD_BITS - bits;
+        /// Folding on whole limbs needs c * 2^padding below 2^62, so carries stay in 128 bits
+        if (c != 0 && bits > (LIMBS - 1) * Element::WORD_BITS && Element(c).bitLength() + padding <= 62) {
+            _c = c;
+            _c_limbs = c << padding;
+            _bits = bits;
+            /// Elements aren't scaled, so conversions multiply by one
+            _r2 = Element(1);
+            _one = Element(1);
+            return;
+        }
+
+        /// Newton's iteration doubles count of correct low bits of p^(-1) mod 2^64
+        uint64_t inverse = 1;
+        for (int i = 0; i < 6; ++i) {
+            inverse *= 2 - _p[0] * inverse;
+        }
+        _p_inv = ~inverse + 1;
+
+        std::vector<uint64_t> r_words(LIMBS + 1, 0);
+        r_words.back() = 1;
+        const BigNum r = fromWords(r_words);
+        _r2 = Element(r * r % mod);
+        _one = Element(r % mod);
+    }
+
+    const BigNum& modulo() const noexcept {
+        return _mod;
+    }
+
+    Element fromBigNum(const BigNum& num) const {
+        return mul(Element(num % _mod), _r2);
+    }
+
+    BigNum toBigNum(const Element& num) const {
+        return static_cast<BigNum>(mul(num, Element(1)));
+    }
+
+    constexpr Element zero() const noexcept {
+        return Element();
+    }
+
+    constexpr const Element& one() const noexcept {
+        return _one;
+    }
+
+    constexpr Element add(const Element& left, const Element& right) const noexcept {
+        Element result;
+        const uint64_t carry = Element::addWithCarry(result, left, right);
+        if (carry != 0 || result >= _p) {
+            Element::subtractWithBorrow(result, result, _p);
+        }
+        return result;
+    }
+
+    constexpr Element sub(const Element& left, const Element& right) const noexcept {
+        Element result;
+        if (Element::subtractWithBorrow(result, left, right) != 0) {
+            Element::addWithCarry(result, result, _p);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Product in representation of elements, see _mulMontgomery() and _mulPseudoMersenne()
+     */
+    constexpr Element mul(const Element& left, const Element& right) const noexcept {
+        return (_c != 0) ? _mulPseudoMersenne(left, right) : _mulMontgomery(left, right);
+    }
+
+    constexpr Element sqr(const Element& num) const noexcept {
+        return mul(num, num);
+    }
+
+    /**
+     * @brief Inversion by Fermat's little theorem, modulo must be prime
+     * @throw std::invalid_argument if num is zero
+     */
+    Element inverse(const Element& num) const {
+        if (num.isZero()) {
+            throw std::invalid_argument("Nums must be coprime.");
+        }
+        return _inversion_exponent.power(num, _one,
+                                         [this](Element& out, const Element& x) { out = sqr(x); },
+                                         [this](Element& out, const Element& x, const Element& y) { out = mul(x, y); });
+    }
+
+private:
+    /**
+     * @brief Montgomery multiplication (CIOS), returns left * right / 2^(64 * LIMBS) mod p
+     */
+    constexpr Element _mulMontgomery(const Element& left, const Element& right) const noexcept {
+        std::array<uint64_t, LIMBS + 2> t{};
+        detail::unroll<LIMBS>([&](auto i) {
+            unsigned __int128 carry = 0;
+            detail::unroll<LIMBS>([&](auto j) {
+                carry += static_cast<unsigned __int128>(left[j]) * right[i] + t[j];
+                t[j] = static_cast<uint64_t>(carry);
+                carry >>= 64;
+            });
+            carry += t[LIMBS];
+            t[LIMBS] = static_cast<uint64_t>(carry);
+            t[LIMBS + 1] = static_cast<uint64_t>(carry >> 64);
+
+            const uint64_t m = t[0] * _p_inv;
+            carry = (static_cast<unsigned __int128>(m) * _p[0] + t[0]) >> 64;
+            detail::unroll<LIMBS - 1>([&](auto j) {
+                carry += static_cast<unsigned __int128>(m) * _p[j + 1] + t[j + 1];
+                t[j] = static_cast<uint64_t>(carry);
+                carry >>= 64;
+            });
+            carry += t[LIMBS];
+            t[LIMBS - 1] = static_cast<uint64_t>(carry);
+            t[LIMBS] = t[LIMBS + 1] + static_cast<uint64_t>(carry >> 64);
+        });
+
+        Element result;
+        detail::unroll<LIMBS>([&](auto i) { result[i] = t[i]; });
+        if (t[LIMBS] != 0 || result >= _p) {
+            Element::subtractWithBorrow(result, result, _p);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Full product folded by hi * 2^(64 * LIMBS) + lo = hi * c * 2^(64 * LIMBS - n) + lo (mod 2^n - c)
+     *        on whole limbs, then bits from n up are folded by c once more, returns left * right mod p
+     */
+    constexpr Element _mulPseudoMersenne(const Element& left, const Element& right) const noexcept {
+        const auto wide = Element::multiplyWide(left, right);
+        const auto addWord = [](Element& num, unsigned __int128 carry) {
+            detail::unroll<LIMBS>([&](auto i) {
+                carry += num[i];
+                num[i] = static_cast<uint64_t>(carry);
+                carry >>= Element::WORD_BITS;
+            });
+            return carry;
+        };
+
+        Element result;
+        unsigned __int128 carry = 0;
+        detail::unroll<LIMBS>([&](auto i) {
+            carry += static_cast<unsigned __int128>(wide[i + LIMBS]) * _c_limbs + wide[i];
+            result[i] = static_cast<uint64_t>(carry);
+            carry >>= Element::WORD_BITS;
+        });
+        /// Carry is at most c_limbs and shrinks with every fold of what wraps around 2^(64 * LIMBS),
+        /// two or more limbs need a single fold, a single limb may need a few
+        while (carry != 0) {
+            carry = addWord(result, carry * _c_limbs);
+        }
+
+        const std::size_t top_bits = _bits - (LIMBS - 1) * Element::WORD_BITS;
+        if (top_bits < Element::WORD_BITS) {
+            const uint64_t low_mask = (uint64_t{1} << top_bits) - 1;
+            for (uint64_t high = result[LIMBS - 1] >> top_bits; high != 0; high = result[LIMBS - 1] >> top_bits) {
+                result[LIMBS - 1] &= low_mask;
+                addWord(result, static_cast<unsigned __int128>(high) * _c);
+            }
+        }
+
+        /// result < 2^n, which is less than 2 * p
+        if (result >= _p) {
+            Element::subtractWithBorrow(result, result, _p);
+        }
+        return result;
+    }
+
+    BigNum _mod;
+    Element _p;
+    /// -p^(-1) mod 2^64
+    uint64_t _p_inv = 0;
+    /// 2^(128 * LIMBS) mod p
+    Element _r2;
+    /// 2^(64 * LIMBS) mod p, which is 1 in Montgomery form
+    Element _one;
+    /// Sliding-window recoding of p - 2
+    ExponentRecoding _inversion_exponent;
+    /// c = 2^n - p for pseudo-Mersenne modulus, zero when Montgomery form is used
+    uint64_t _c = 0;
+    /// 2^(64 * LIMBS) mod p = c * 2^(64 * LIMBS - n)
+    uint64_t _c_limbs = 0;
+    /// Bit length n of pseudo-Mersenne modulus
+    std::size_t _bits = 0;
+};
+
+} // namespace lab
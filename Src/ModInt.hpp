@@ -0,0 +1,299 @@
+#pragma once
+
+#include "BigNum.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace lab {
+
+namespace detail {
+    /**
+     * @return -p^(-1) mod 2^64 for odd p, Newton's iteration doubles count of correct bits
+     */
+    constexpr uint64_t negatedInverse64(uint64_t p) noexcept {
+        uint64_t inverse = 1;
+        for (int i = 0; i < 6; ++i) {
+            inverse *= 2 - p * inverse;
+        }
+        return ~inverse + 1;
+    }
+
+    /**
+     * @brief Montgomery reduction of t < p * 2^64, returns t / 2^64 mod p
+     */
+    constexpr uint64_t redc64(unsigned __int128 t, uint64_t p, uint64_t p_inv) noexcept {
+        const uint64_t m = static_cast<uint64_t>(t) * p_inv;
+        const uint64_t result = static_cast<uint64_t>((t + static_cast<unsigned __int128>(m) * p) >> 64);
+        return result >= p ? result - p : result;
+    }
+
+    /**
+     * @return Residue of num modulo p computed over binary words of num
+     */
+    inline uint64_t reduceToWord(const BigNum& num, uint64_t p) {
+        const auto words = toWords(num);
+        unsigned __int128 remainder = 0;
+        for (auto word = words.rbegin(); word != words.rend(); ++word) {
+            remainder = ((remainder << 64) | *word) % p;
+        }
+        return static_cast<uint64_t>(remainder);
+    }
+} // namespace detail
+
+/**
+ * @brief Prime field over odd modulus below 2^63 computed in machine registers,
+ *        elements are uint64_t kept in Montgomery form x * 2^64 mod p
+ */
+class ModInt64Field
+{
+public:
+    using Element = uint64_t;
+
+    /**
+     * @brief Maximum count of bits in modulo
+     */
+    static constexpr std::size_t MAX_BITS = 63;
+
+    ModInt64Field() = default;
+
+    /**
+     * @throw std::invalid_argument if mod is even or has more than MAX_BITS bits
+     */
+    explicit ModInt64Field(const BigNum& mod)
+        : _mod(mod)
+    {
+        const auto words = toWords(mod);
+        if (words.size() != 1 || (words[0] >> MAX_BITS) != 0 || words[0] % 2 == 0) {
+            throw std::invalid_argument("Modulo of ModInt64Field must be odd and less than 2^63");
+        }
+        _p = words[0];
+        _p_inv = detail::negatedInverse64(_p);
+        _r2 = static_cast<uint64_t>((static_cast<unsigned __int128>(1) << 64) % _p);
+        _r2 = static_cast<uint64_t>(static_cast<unsigned __int128>(_r2) * _r2 % _p);
+        _one = detail::redc64(_r2, _p, _p_inv);
+    }
+
+    /**
+     * @return True if curves over mod can run on this field
+     */
+    static bool fits(const BigNum& mod) {
+        const auto words = toWords(mod);
+        return words.size() == 1 && (words[0] >> MAX_BITS) == 0 && words[0] % 2 == 1;
+    }
+
+    const BigNum& modulo() const noexcept {
+        return _mod;
+    }
+
+    Element fromBigNum(const BigNum& num) const {
+        return mul(detail::reduceToWord(num, _p), _r2);
+    }
+
+    BigNum toBigNum(Element num) const {
+        return fromWords({detail::redc64(num, _p, _p_inv)});
+    }
+
+    constexpr Element zero() const noexcept {
+        return 0;
+    }
+
+    constexpr Element one() const noexcept {
+        return _one;
+    }
+
+    constexpr Element add(Element left, Element right) const noexcept {
+        const uint64_t result = left + right;
+        return result >= _p ? result - _p : result;
+    }
+
+    constexpr Element sub(Element left, Element right) const noexcept {
+        return left >= right ? left - right : left + _p - right;
+    }
+
+    constexpr Element mul(Element left, Element right) const noexcept {
+        return detail::redc64(static_cast<unsigned __int128>(left) * right, _p, _p_inv);
+    }
+
+    constexpr Element sqr(Element num) const noexcept {
+        return mul(num, num);
+    }
+
+    /**
+     * @brief Inversion by Fermat's little theorem, modulo must be prime
+     * @throw std::invalid_argument if num is zero
+     */
+    Element inverse(Element num) const {
+        if (num == 0) {
+            throw std::invalid_argument("Nums must be coprime.");
+        }
+        Element result = _one;
+        for (uint64_t degree = _p - 2; degree != 0; degree >>= 1) {
+            if (degree & 1) {
+                result = mul(result, num);
+            }
+            num = sqr(num);
+        }
+        return result;
+    }
+
+private:
+    BigNum _mod;
+    uint64_t _p = 1;
+    /// -p^(-1) mod 2^64
+    uint64_t _p_inv = 0;
+    /// 2^128 mod p
+    uint64_t _r2 = 0;
+    /// 2^64 mod p, which is 1 in Montgomery form
+    uint64_t _one = 0;
+};
+
+/**
+ * @brief Residue modulo compile-time odd prime P below 2^63, kept in Montgomery form
+ */
+template <uint64_t P>
+class ModInt
+{
+public:
+    static_assert(P % 2 == 1 && (P >> 63) == 0, "ModInt needs odd modulo less than 2^63");
+
+    static constexpr uint64_t MOD = P;
+
+    constexpr ModInt() = default;
+
+    constexpr explicit ModInt(uint64_t value) noexcept
+        : _value(detail::redc64(static_cast<unsigned __int128>(value % P) * R2, P, P_INV))
+    { }
+
+    explicit ModInt(const BigNum& num)
+        : ModInt(detail::reduceToWord(num, P))
+    { }
+
+    /**
+     * @return Residue in range [0, P)
+     */
+    constexpr uint64_t value() const noexcept {
+        return detail::redc64(_value, P, P_INV);
+    }
+
+    explicit operator BigNum() const {
+        return fromWords({value()});
+    }
+
+    friend constexpr ModInt operator+(ModInt left, ModInt right) noexcept {
+        const uint64_t result = left._value + right._value;
+        return fromMontgomery(result >= P ? result - P : result);
+    }
+
+    friend constexpr ModInt operator-(ModInt left, ModInt right) noexcept {
+        return fromMontgomery(left._value >= right._value ? left._value - right._value : left._value + P - right._value);
+    }
+
+    friend constexpr ModInt operator*(ModInt left, ModInt right) noexcept {
+        return fromMontgomery(detail::redc64(static_cast<unsigned __int128>(left._value) * right._value, P, P_INV));
+    }
+
+    /**
+     * @throw std::invalid_argument if right is zero
+     */
+    friend constexpr ModInt operator/(ModInt left, ModInt right) {
+        return left * right.inverse();
+    }
+
+    friend constexpr bool operator==(ModInt left, ModInt right) noexcept {
+        return left._value == right._value;
+    }
+
+    friend constexpr bool operator!=(ModInt left, ModInt right) noexcept {
+        return left._value != right._value;
+    }
+
+    constexpr ModInt pow(uint64_t degree) const noexcept {
+        ModInt result(1);
+        ModInt base = *this;
+        for (; degree != 0; degree >>= 1) {
+            if (degree & 1) {
+                result = result * base;
+            }
+            base = base * base;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Inversion by Fermat's little theorem, P must be prime
+     * @throw std::invalid_argument if number is zero
+     */
+    constexpr ModInt inverse() const {
+        if (_value == 0) {
+            throw std::invalid_argument("Nums must be coprime.");
+        }
+        return pow(P - 2);
+    }
+
+private:
+    static constexpr uint64_t P_INV = detail::negatedInverse64(P);
+    static constexpr uint64_t R = static_cast<uint64_t>((static_cast<unsigned __int128>(1) << 64) % P);
+    static constexpr uint64_t R2 = static_cast<uint64_t>(static_cast<unsigned __int128>(R) * R % P);
+
+    static constexpr ModInt fromMontgomery(uint64_t value) noexcept {
+        ModInt result;
+        result._value = value;
+        return result;
+    }
+
+    uint64_t _value = 0;
+};
+
+/**
+ * @brief Field backend over ModInt<P> for BasicEllipticCurve
+ */
+template <uint64_t P>
+class ModIntField
+{
+public:
+    using Element = ModInt<P>;
+
+    const BigNum& modulo() const {
+        static const BigNum mod = fromWords({P});
+        return mod;
+    }
+
+    Element fromBigNum(const BigNum& num) const {
+        return Element(num);
+    }
+
+    BigNum toBigNum(Element num) const {
+        return static_cast<BigNum>(num);
+    }
+
+    constexpr Element zero() const noexcept {
+        return Element();
+    }
+
+    constexpr Element one() const noexcept {
+        return Element(1);
+    }
+
+    constexpr Element add(Element left, Element right) const noexcept {
+        return left + right;
+    }
+
+    constexpr Element sub(Element left, Element right) const noexcept {
+        return left - right;
+    }
+
+    constexpr Element mul(Element left, Element right) const noexcept {
+        return left * right;
+    }
+
+    constexpr Element sqr(Element num) const noexcept {
+        return num * num;
+    }
+
+    Element inverse(Element num) const {
+        return num.inverse();
+    }
+};
+
+} // namespace lab
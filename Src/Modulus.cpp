@@ -0,0 +1,1010 @@
+#include <Modulus.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace lab {
+
+BarrettReducer::BarrettReducer(const BigNum& mod)
+    : _mod(mod)
+    , _k(mod._digits.size())
+{
+    if (mod == 0) {
+        throw std::invalid_argument("Modulo must not be 0");
+    }
+
+    BigNum base_power;
+    base_power._digits.assign(2 * _k + 1, 0);
+    base_power._digits.back() = 1;
+    _mu = base_power / _mod;
+
+    _base_power._digits.assign(_k + 2, 0);
+    _base_power._digits.back() = 1;
+}
+
+const BigNum& BarrettReducer::modulo() const noexcept {
+    return _mod;
+}
+
+BigNum BarrettReducer::reduce(const BigNum& num) const {
+    BigNum result = num;
+    reduceInPlace(result);
+    return result;
+}
+
+void BarrettReducer::reduceInPlace(BigNum& num) const {
+    if (num < _mod) {
+        return;
+    }
+    if (num._digits.size() > 2 * _k) {
+        num %= _mod;
+        return;
+    }
+
+    /// Intermediate products live in buffers of the calling thread, they stop allocating once grown
+    thread_local BigNum high, q, q_mod;
+
+    /// q = ((num / NUM_BASE^(k-1)) * mu) / NUM_BASE^(k+1)
+    high._digits.assign(num._digits.begin() + (_k - 1), num._digits.end());
+    multiplyInto(q, high, _mu);
+    if (q._digits.size() > _k + 1) {
+        std::copy(q._digits.begin() + (_k + 1), q._digits.end(), q._digits.begin());
+        q._digits.resize(q._digits.size() - (_k + 1));
+    } else {
+        q._digits.assign(1, 0);
+    }
+
+    /// r = (num - q * mod) % NUM_BASE^(k+1)
+    multiplyInto(q_mod, q, _mod);
+    if (q_mod._digits.size() > _k + 1) {
+        q_mod._digits.resize(_k + 1);
+        q_mod._trim();
+    }
+    if (num._digits.size() > _k + 1) {
+        num._digits.resize(_k + 1);
+        num._trim();
+    }
+    if (num < q_mod) {
+        num += _base_power;
+    }
+    num -= q_mod;
+
+    /// At most two corrections are needed
+    while (num >= _mod) {
+        num -= _mod;
+    }
+}
+
+bool operator==(const BarrettReducer& left, const BarrettReducer& right) noexcept {
+    return left._mod == right._mod;
+}
+
+bool operator!=(const BarrettReducer& left, const BarrettReducer& right) noexcept {
+    return !(left == right);
+}
+
+namespace {
+    /**
+     * @brief Operations shared by all reduction contexts, Context must provide reduce() and modulo()
+     */
+    template <typename Context>
+    BigNum addWith(const BigNum& first, const BigNum& second, const Context& ctx) {
+        BigNum result = ctx.reduce(first) + ctx.reduce(second);
+        if (result >= ctx.modulo()) {
+            result -= ctx.modulo();
+        }
+        return result;
+    }
+
+    template <typename Context>
+    BigNum subtractWith(const BigNum& first, const BigNum& second, const Context& ctx) {
+        const auto t_num1 = ctx.reduce(first);
+        const auto t_num2 = ctx.reduce(second);
+        if (t_num1 >= t_num2) {
+            return t_num1 - t_num2;
+        }
+        return ctx.modulo() - t_num2 + t_num1;
+    }
+
+    template <typename Context>
+    BigNum multiplyWith(const BigNum& lhs, const BigNum& rhs, const Context& ctx) {
+        return ctx.reduce(ctx.reduce(lhs) * ctx.reduce(rhs));
+    }
+
+    /**
+     * @brief Square-and-multiply over binary digits of degree, two buffers are swapped on every step
+     */
+    template <typename Context>
+    BigNum powWith(const BigNum& base, const BigNum& degree, const Context& ctx) {
+        const auto degree_words = toWords(degree);
+        const BigNum reduced_base = ctx.reduce(base);
+        BigNum result = ctx.reduce(1_bn);
+        BigNum product;
+        for (std::size_t bit = degree_words.size() * 64; bit-- > 0;) {
+            sqrMod(product, result, ctx);
+            result.swap(product);
+            if ((degree_words[bit / 64] >> (bit % 64)) & 1) {
+                mulMod(product, result, reduced_base, ctx);
+                result.swap(product);
+            }
+        }
+        return result;
+    }
+
+    template <typename Context>
+    void addModWith(BigNum& out, const BigNum& first, const BigNum& second, const Context& ctx) {
+        addInto(out, first, second);
+        ctx.reduceInPlace(out);
+    }
+
+    template <typename Context>
+    void subModWith(BigNum& out, const BigNum& first, const BigNum& second, const Context& ctx) {
+        if (first >= ctx.modulo() || second >= ctx.modulo()) {
+            out = subtractWith(first, second, ctx);
+        } else if (first >= second) {
+            subtractInto(out, first, second);
+        } else if (&out != &second) {
+            /// first + (mod - second) without temporaries
+            addInto(out, first, ctx.modulo());
+            out -= second;
+        } else {
+            /// mod - (second - first)
+            subtractInto(out, second, first);
+            subtractInto(out, ctx.modulo(), out);
+        }
+    }
+
+    template <typename Context>
+    void mulModWith(BigNum& out, const BigNum& lhs, const BigNum& rhs, const Context& ctx) {
+        multiplyInto(out, lhs, rhs);
+        ctx.reduceInPlace(out);
+    }
+
+    template <typename Context>
+    BigNum invertedWith(const BigNum& num, const Context& ctx, BigNum::InversionPolicy policy) {
+        if (policy == BigNum::InversionPolicy::Euclid) {
+            return inverted(num, ctx.modulo(), policy);
+        }
+
+        /// For prime modulo being coprime is the same as being non-zero
+        if (ctx.reduce(num) == 0) {
+            throw std::invalid_argument("Nums must be coprime.");
+        }
+        return powWith(num, ctx.modulo() - 2, ctx);
+    }
+} // <anonymous> namespace
+
+void modify(BigNum& num, const BarrettReducer& ctx) {
+    num = ctx.reduce(num);
+}
+
+BigNum add(const BigNum& first, const BigNum& second, const BarrettReducer& ctx) {
+    return addWith(first, second, ctx);
+}
+
+BigNum subtract(const BigNum& first, const BigNum& second, const BarrettReducer& ctx) {
+    return subtractWith(first, second, ctx);
+}
+
+BigNum multiply(const BigNum& lhs, const BigNum& rhs, const BarrettReducer& ctx) {
+    return multiplyWith(lhs, rhs, ctx);
+}
+
+BigNum pow(const BigNum& base, const BigNum& degree, const BarrettReducer& ctx) {
+    return powWith(base, degree, ctx);
+}
+
+BigNum inverted(const BigNum& num, const BarrettReducer& ctx, BigNum::InversionPolicy policy) {
+    return invertedWith(num, ctx, policy);
+}
+
+void addMod(BigNum& out, const BigNum& first, const BigNum& second, const BarrettReducer& ctx) {
+    addModWith(out, first, second, ctx);
+}
+
+void subMod(BigNum& out, const BigNum& first, const BigNum& second, const BarrettReducer& ctx) {
+    subModWith(out, first, second, ctx);
+}
+
+void mulMod(BigNum& out, const BigNum& lhs, const BigNum& rhs, const BarrettReducer& ctx) {
+    mulModWith(out, lhs, rhs, ctx);
+}
+
+void sqrMod(BigNum& out, const BigNum& num, const BarrettReducer& ctx) {
+    mulModWith(out, num, num, ctx);
+}
+
+namespace {
+    /**
+     * @brief Maximum count of signed binary digits in d = 2^n - mod for Solinas form
+     */
+    constexpr std::size_t MAX_SOLINAS_TERMS = 8;
+
+    /**
+     * @brief Minimum count of bits each folding step of Solinas reduction must remove
+     */
+    constexpr std::size_t MIN_SOLINAS_GAP = 32;
+
+    constexpr std::size_t WORD_BITS = 64;
+
+    void trimWords(std::vector<uint64_t>& words) {
+        while (words.size() > 1 && words.back() == 0) {
+            words.pop_back();
+        }
+        if (words.empty()) {
+            words.push_back(0);
+        }
+    }
+
+    std::size_t bitLength(const std::vector<uint64_t>& words) {
+        for (std::size_t i = words.size(); i > 0; --i) {
+            if (words[i - 1] != 0) {
+                return i * WORD_BITS - __builtin_clzll(words[i - 1]);
+            }
+        }
+        return 0;
+    }
+
+    bool isLowerWords(const std::vector<uint64_t>& left, const std::vector<uint64_t>& right) {
+        if (left.size() != right.size()) {
+            return left.size() < right.size();
+        }
+        for (std::size_t i = left.size(); i > 0; --i) {
+            if (left[i - 1] != right[i - 1]) {
+                return left[i - 1] < right[i - 1];
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Writes bits of words starting from @a from into @a result
+     */
+    void highBits(std::vector<uint64_t>& result, const std::vector<uint64_t>& words, std::size_t from) {
+        const std::size_t word_shift = from / WORD_BITS;
+        const std::size_t bit_shift = from % WORD_BITS;
+        result.clear();
+        for (std::size_t i = word_shift; i < words.size(); ++i) {
+            uint64_t word = words[i] >> bit_shift;
+            if (bit_shift != 0 && i + 1 < words.size()) {
+                word |= words[i + 1] << (WORD_BITS - bit_shift);
+            }
+            result.push_back(word);
+        }
+        trimWords(result);
+    }
+
+    /**
+     * @brief Keeps only first @a count bits of words
+     */
+    void truncateBits(std::vector<uint64_t>& words, std::size_t count) {
+        const std::size_t word_count = (count + WORD_BITS - 1) / WORD_BITS;
+        if (words.size() > word_count) {
+            words.resize(word_count);
+        }
+        if (count % WORD_BITS != 0 && words.size() == word_count) {
+            words.back() &= (uint64_t{1} << (count % WORD_BITS)) - 1;
+        }
+        trimWords(words);
+    }
+
+    /**
+     * @brief acc += num * 2^shift
+     */
+    void addShiftedWords(std::vector<uint64_t>& acc, const std::vector<uint64_t>& num, std::size_t shift) {
+        const std::size_t word_shift = shift / WORD_BITS;
+        const std::size_t bit_shift = shift % WORD_BITS;
+        acc.resize(std::max(acc.size(), num.size() + word_shift + 1) + 1, 0);
+
+        unsigned __int128 addition = 0;
+        for (std::size_t i = 0; i <= num.size() || addition != 0; ++i) {
+            uint64_t word = i < num.size() ? num[i] << bit_shift : 0;
+            if (bit_shift != 0 && i > 0 && i - 1 < num.size()) {
+                word |= num[i - 1] >> (WORD_BITS - bit_shift);
+            }
+            addition += static_cast<unsigned __int128>(acc[i + word_shift]) + word;
+            acc[i + word_shift] = static_cast<uint64_t>(addition);
+            addition >>= WORD_BITS;
+        }
+        trimWords(acc);
+    }
+
+    /**
+     * @brief acc -= num * 2^shift, acc must be not less than subtrahend
+     */
+    void subtractShiftedWords(std::vector<uint64_t>& acc, const std::vector<uint64_t>& num, std::size_t shift) {
+        const std::size_t word_shift = shift / WORD_BITS;
+        const std::size_t bit_shift = shift % WORD_BITS;
+
+        uint64_t borrow = 0;
+        for (std::size_t i = 0; i + word_shift < acc.size() && (i <= num.size() || borrow != 0); ++i) {
+            uint64_t word = i < num.size() ? num[i] << bit_shift : 0;
+            if (bit_shift != 0 && i > 0 && i - 1 < num.size()) {
+                word |= num[i - 1] >> (WORD_BITS - bit_shift);
+            }
+            uint64_t& cell = acc[i + word_shift];
+            const uint64_t next_borrow = (cell < word) || (cell - word < borrow);
+            cell = cell - word - borrow;
+            borrow = next_borrow;
+        }
+        trimWords(acc);
+    }
+
+    /**
+     * @brief Schoolbook multiplication of binary numbers into @a result, which must not be one of operands
+     */
+    void multiplyWords(std::vector<uint64_t>& result, const std::vector<uint64_t>& lhs, const std::vector<uint64_t>& rhs) {
+        result.assign(lhs.size() + rhs.size(), 0);
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            unsigned __int128 addition = 0;
+            for (std::size_t j = 0; j < rhs.size(); ++j) {
+                addition += static_cast<unsigned __int128>(lhs[i]) * rhs[j] + result[i + j];
+                result[i + j] = static_cast<uint64_t>(addition);
+                addition >>= WORD_BITS;
+            }
+            result[i + rhs.size()] = static_cast<uint64_t>(addition);
+        }
+        trimWords(result);
+    }
+
+    /**
+     * @brief Non-adjacent form of number, pairs of exponent and sign of nonzero digits
+     */
+    std::vector<std::pair<std::size_t, int>> nonAdjacentForm(std::vector<uint64_t> num) {
+        std::vector<std::pair<std::size_t, int>> terms;
+        for (std::size_t exponent = 0; !(num.size() == 1 && num[0] == 0); ++exponent) {
+            if (num[0] % 2 == 1) {
+                /// Digit is 1 for num = 1 (mod 4) and -1 for num = 3 (mod 4)
+                if (num[0] % 4 == 1) {
+                    terms.emplace_back(exponent, 1);
+                    subtractShiftedWords(num, {1}, 0);
+                } else {
+                    terms.emplace_back(exponent, -1);
+                    addShiftedWords(num, {1}, 0);
+                }
+            }
+            std::vector<uint64_t> shifted;
+            highBits(shifted, num, 1);
+            num.swap(shifted);
+        }
+        return terms;
+    }
+} // <anonymous> namespace
+
+ExponentRecoding::ExponentRecoding(const BigNum& degree) {
+    const auto words = toWords(degree);
+    const std::size_t bits = bitLength(words);
+    _width = bits <= 24 ? 2 : bits <= 80 ? 3 : bits <= 240 ? 4 : bits <= 672 ? 5 : 6;
+
+    const auto bitAt = [&words](std::size_t bit) {
+        return (words[bit / WORD_BITS] >> (bit % WORD_BITS)) & 1;
+    };
+
+    /// Windows are taken from the top, each ends at the lowest nonzero bit within width
+    std::size_t squarings = 0;
+    for (std::size_t top = bits; top > 0;) {
+        if (bitAt(top - 1) == 0) {
+            squarings += 1;
+            top -= 1;
+            continue;
+        }
+
+        std::size_t low = top > _width ? top - _width : 0;
+        while (bitAt(low) == 0) {
+            low += 1;
+        }
+        uint64_t value = 0;
+        for (std::size_t bit = top; bit-- > low;) {
+            value = (value << 1) | bitAt(bit);
+        }
+
+        squarings += top - low;
+        const std::size_t odd_index = static_cast<std::size_t>(value / 2);
+        _steps.push_back({squarings, odd_index});
+        _table_size = std::max(_table_size, odd_index + 1);
+        squarings = 0;
+        top = low;
+    }
+    _trailing_squarings = squarings;
+}
+
+std::size_t ExponentRecoding::width() const noexcept {
+    return _width;
+}
+
+std::size_t ExponentRecoding::multiplications() const noexcept {
+    if (_steps.empty()) {
+        return 0;
+    }
+    /// Table takes one squaring and _table_size - 1 multiplications
+    std::size_t result = (_table_size > 1 ? _table_size : 0) + _steps.size() - 1 + _trailing_squarings;
+    for (std::size_t i = 1; i < _steps.size(); i++) {
+        result += _steps[i].squarings;
+    }
+    return result;
+}
+
+Modulus::Modulus(const BigNum& mod)
+    : _barrett(mod)
+    , _words(toWords(mod))
+    , _bits(bitLength(_words))
+{
+    if (mod > 2_bn) {
+        _inversion_exponent = ExponentRecoding(mod - 2);
+    }
+
+    std::vector<uint64_t> d(_words.size() + 1, 0);
+    d[_bits / WORD_BITS] = uint64_t{1} << (_bits % WORD_BITS);
+    trimWords(d);
+    subtractShiftedWords(d, _words, 0);
+    const std::size_t d_bits = bitLength(d);
+
+    /// 2^n - mod where mod is a power of two doesn't allow folding
+    if (d_bits >= _bits) {
+        return;
+    }
+
+    if (d.size() == 1 && 2 * d_bits <= _bits) {
+        _form = ModulusForm::PseudoMersenne;
+        _c = d[0];
+    }
+
+    auto terms = nonAdjacentForm(d);
+    if (terms.size() <= MAX_SOLINAS_TERMS && terms.back().first + MIN_SOLINAS_GAP <= _bits) {
+        _terms = std::move(terms);
+        if (_form == ModulusForm::Generic) {
+            _form = ModulusForm::Solinas;
+        }
+    }
+}
+
+Modulus::Modulus(const BigNum& mod, ModulusForm form)
+    : Modulus(mod)
+{
+    if (form == ModulusForm::Generic) {
+        _form = form;
+        return;
+    }
+
+    const bool is_supported = (form == ModulusForm::PseudoMersenne) ? (_c != 0) : !_terms.empty();
+    if (!is_supported) {
+        throw std::invalid_argument("Modulo doesn't have the declared form");
+    }
+    _form = form;
+}
+
+const BigNum& Modulus::modulo() const noexcept {
+    return _barrett.modulo();
+}
+
+ModulusForm Modulus::form() const noexcept {
+    return _form;
+}
+
+uint64_t Modulus::pseudoMersenneConstant() const noexcept {
+    return (_form == ModulusForm::PseudoMersenne) ? _c : 0;
+}
+
+BigNum Modulus::reduce(const BigNum& num) const {
+    /// Converting a single number to binary and back costs more than Barrett's reduction,
+    /// special forms pay off only while numbers stay binary, see pow()
+    return _barrett.reduce(num);
+}
+
+void Modulus::reduceInPlace(BigNum& num) const {
+    _barrett.reduceInPlace(num);
+}
+
+BigNum Modulus::pow(const BigNum& base, const BigNum& degree) const {
+    if (_form == ModulusForm::Generic) {
+        return lab::pow(base, degree, _barrett);
+    }
+
+    const auto base_words = toWords(_barrett.reduce(base));
+    const auto degree_words = toWords(degree);
+    Scratch scratch;
+    std::vector<uint64_t> result{1};
+    std::vector<uint64_t> product;
+    _reduce(result, scratch);
+
+    for (std::size_t bit = bitLength(degree_words); bit-- > 0;) {
+        multiplyWords(product, result, result);
+        _reduce(product, scratch);
+        result.swap(product);
+        if ((degree_words[bit / WORD_BITS] >> (bit % WORD_BITS)) & 1) {
+            multiplyWords(product, result, base_words);
+            _reduce(product, scratch);
+            result.swap(product);
+        }
+    }
+    return fromWords(result);
+}
+
+BigNum Modulus::pow(const BigNum& base, const ExponentRecoding& degree) const {
+    BigNum result;
+    pow(result, base, degree);
+    return result;
+}
+
+void Modulus::pow(BigNum& out, const BigNum& base, const ExponentRecoding& degree) const {
+    if (_form == ModulusForm::Generic) {
+        thread_local BigNum reduced_base, buffer;
+        thread_local std::vector<BigNum> odd_powers;
+        const auto square = [this](BigNum& result, const BigNum& num) {
+            sqrMod(result, num, _barrett);
+        };
+        const auto product = [this](BigNum& result, const BigNum& left, const BigNum& right) {
+            mulMod(result, left, right, _barrett);
+        };
+        reduced_base = base;
+        _barrett.reduceInPlace(reduced_base);
+        degree.power(out, reduced_base, _barrett.reduce(1_bn), odd_powers, buffer, square, product);
+        return;
+    }
+
+    thread_local Scratch scratch;
+    thread_local std::vector<uint64_t> base_words, one, result, buffer;
+    thread_local std::vector<std::vector<uint64_t>> odd_powers;
+    const auto product = [this](std::vector<uint64_t>& words, const std::vector<uint64_t>& left,
+                                const std::vector<uint64_t>& right) {
+        multiplyWords(words, left, right);
+        _reduce(words, scratch);
+    };
+    const auto square = [&product](std::vector<uint64_t>& words, const std::vector<uint64_t>& num) {
+        product(words, num, num);
+    };
+    one.assign(1, 1);
+    _reduce(one, scratch);
+    toWords(base_words, base);
+    _reduce(base_words, scratch);
+    degree.power(result, base_words, one, odd_powers, buffer, square, product);
+    fromWords(out, result);
+}
+
+const ExponentRecoding& Modulus::inversionExponent() const& noexcept {
+    return _inversion_exponent;
+}
+
+void Modulus::reduce(std::vector<uint64_t>& words) const {
+    Scratch scratch;
+    _reduce(words, scratch);
+}
+
+void Modulus::_reduce(std::vector<uint64_t>& words, Scratch& scratch) const {
+    trimWords(words);
+    switch (_form) {
+    case ModulusForm::PseudoMersenne:
+        _foldPseudoMersenne(words, scratch);
+        break;
+    case ModulusForm::Solinas:
+        _foldSolinas(words, scratch);
+        break;
+    case ModulusForm::Generic:
+        words = toWords(_barrett.reduce(fromWords(words)));
+        return;
+    }
+
+    /// After folding words < 2^n, which is less than 2 * mod
+    if (!isLowerWords(words, _words)) {
+        subtractShiftedWords(words, _words, 0);
+    }
+}
+
+void Modulus::_foldPseudoMersenne(std::vector<uint64_t>& words, Scratch& scratch) const {
+    auto& high = scratch.high;
+    auto& product = scratch.product;
+
+    /// hi * 2^n + lo = hi * c + lo (mod 2^n - c)
+    while (bitLength(words) > _bits) {
+        highBits(high, words, _bits);
+        truncateBits(words, _bits);
+
+        product.assign(high.size() + 1, 0);
+        unsigned __int128 addition = 0;
+        for (std::size_t i = 0; i < high.size(); ++i) {
+            addition += static_cast<unsigned __int128>(high[i]) * _c;
+            product[i] = static_cast<uint64_t>(addition);
+            addition >>= WORD_BITS;
+        }
+        product.back() = static_cast<uint64_t>(addition);
+
+        addShiftedWords(words, product, 0);
+    }
+}
+
+void Modulus::_foldSolinas(std::vector<uint64_t>& words, Scratch& scratch) const {
+    auto& high = scratch.high;
+
+    /// hi * 2^n + lo = lo + hi * sum(sign * 2^e) (mod 2^n - sum(sign * 2^e)),
+    /// positive terms are added first so the result never becomes negative
+    while (bitLength(words) > _bits) {
+        highBits(high, words, _bits);
+        truncateBits(words, _bits);
+
+        for (const auto& [exponent, sign] : _terms) {
+            if (sign > 0) {
+                addShiftedWords(words, high, exponent);
+            }
+        }
+        for (const auto& [exponent, sign] : _terms) {
+            if (sign < 0) {
+                subtractShiftedWords(words, high, exponent);
+            }
+        }
+    }
+}
+
+bool operator==(const Modulus& left, const Modulus& right) noexcept {
+    return left.modulo() == right.modulo();
+}
+
+bool operator!=(const Modulus& left, const Modulus& right) noexcept {
+    return !(left == right);
+}
+
+void modify(BigNum& num, const Modulus& ctx) {
+    num = ctx.reduce(num);
+}
+
+BigNum add(const BigNum& first, const BigNum& second, const Modulus& ctx) {
+    return addWith(first, second, ctx);
+}
+
+BigNum subtract(const BigNum& first, const BigNum& second, const Modulus& ctx) {
+    return subtractWith(first, second, ctx);
+}
+
+BigNum multiply(const BigNum& lhs, const BigNum& rhs, const Modulus& ctx) {
+    return multiplyWith(lhs, rhs, ctx);
+}
+
+BigNum pow(const BigNum& base, const BigNum& degree, const Modulus& ctx) {
+    return ctx.pow(base, degree);
+}
+
+BigNum inverted(const BigNum& num, const Modulus& ctx, BigNum::InversionPolicy policy) {
+    if (policy == BigNum::InversionPolicy::Euclid) {
+        return inverted(num, ctx.modulo(), policy);
+    }
+
+    /// For prime modulo being coprime is the same as being non-zero
+    if (ctx.reduce(num) == 0) {
+        throw std::invalid_argument("Nums must be coprime.");
+    }
+    return ctx.pow(num, ctx.inversionExponent());
+}
+
+std::optional<std::pair<BigNum, BigNum>> sqrt(const BigNum& num, const Modulus& ctx) {
+    return SqrtContext::cached(ctx)->sqrt(num);
+}
+
+SqrtContext::SqrtContext(const Modulus& ctx)
+    : _ctx(ctx)
+{
+    const auto& p = _ctx.modulo();
+    if (p <= 2_bn) {
+        return;
+    }
+
+    _q = p - 1;
+    while (isEven(_q)) {
+        _q >>= 1;
+        _s += 1;
+    }
+    _q_exponent = ExponentRecoding(_q);
+    _half_q_exponent = ExponentRecoding((_q + 1) >> 1);
+    _euler_exponent = (p - 1) >> 1;
+    if (lowBits(p, 2) == 3) {
+        _shortcut_exponent = ExponentRecoding((p + 1) >> 2);
+    } else if (lowBits(p, 3) == 5) {
+        _shortcut_exponent = ExponentRecoding((p - 5) >> 3);
+    }
+
+    /// The smallest non-residue, for prime p it is below 2 * ln(p)^2 under GRH
+    BigNum z = 2_bn;
+    while (z < p && _isResidue(z)) {
+        z += 1;
+    }
+    _c_powers.reserve(_s);
+    _c_powers.push_back(_ctx.pow(z, _q));
+    while (_c_powers.size() < _s) {
+        _c_powers.push_back(multiply(_c_powers.back(), _c_powers.back(), _ctx));
+    }
+}
+
+namespace {
+    /**
+     * @brief Contexts of this thread, the most recently used first
+     */
+    std::vector<std::shared_ptr<const SqrtContext>>& sqrtContexts() {
+        thread_local std::vector<std::shared_ptr<const SqrtContext>> contexts;
+        return contexts;
+    }
+
+    /**
+     * @brief Moves context for @a mod to the front of cache, builds it by @a make if it is missing
+     */
+    template <typename Make>
+    std::shared_ptr<const SqrtContext> findSqrtContext(const BigNum& mod, Make&& make) {
+        auto& contexts = sqrtContexts();
+        auto found = std::find_if(contexts.begin(), contexts.end(), [&mod](const auto& context) {
+            return context->modulus().modulo() == mod;
+        });
+        if (found == contexts.end()) {
+            if (contexts.size() == SqrtContext::CACHE_SIZE) {
+                contexts.pop_back();
+            }
+            contexts.push_back(std::make_shared<const SqrtContext>(make()));
+            found = contexts.end() - 1;
+        }
+        std::rotate(contexts.begin(), found, found + 1);
+        return contexts.front();
+    }
+} // <anonymous> namespace
+
+std::shared_ptr<const SqrtContext> SqrtContext::cached(const Modulus& ctx) {
+    return findSqrtContext(ctx.modulo(), [&ctx] { return SqrtContext(ctx); });
+}
+
+std::shared_ptr<const SqrtContext> SqrtContext::cached(const BigNum& mod) {
+    return findSqrtContext(mod, [&mod] { return SqrtContext(Modulus(mod)); });
+}
+
+const Modulus& SqrtContext::modulus() const noexcept {
+    return _ctx;
+}
+
+std::optional<std::pair<BigNum, BigNum>> SqrtContext::sqrt(const BigNum& num, SqrtMethod method) const {
+    const auto& p = _ctx.modulo();
+    const auto a = _ctx.reduce(num);
+    if (a == 0 || p <= 2_bn) {
+        return std::pair{a, a};
+    }
+
+    if (isOdd(p) && jacobi(a, p) == -1) {
+        return {};
+    }
+
+    BigNum root;
+    if (method == SqrtMethod::Cipolla) {
+        root = _cipolla(a);
+    } else if (method == SqrtMethod::Auto && lowBits(p, 2) == 3) {
+        /// a^((p + 1) / 4) squares to a * a^((p - 1) / 2), which is a for residues
+        root = _ctx.pow(a, _shortcut_exponent);
+    } else if (method == SqrtMethod::Auto && lowBits(p, 3) == 5) {
+        root = _atkin(a);
+    } else {
+        root = _tonelliShanks(a);
+    }
+
+    /// Every method returns garbage for non-residues, so the root is checked
+    if (multiply(root, root, _ctx) != a) {
+        return {};
+    }
+    return std::pair{root, p - root};
+}
+
+BigNum SqrtContext::_tonelliShanks(const BigNum& num) const {
+    /// Invariants: r^2 = num * t, order of t divides 2^(m - 1), multipliers are c^(2^(s - m + j)) from table
+    auto r = _ctx.pow(num, _half_q_exponent);
+    auto t = _ctx.pow(num, _q_exponent);
+    std::size_t m = _s;
+    while (t != 1) {
+        /// The least i with t^(2^i) = 1, reaching m means num isn't a residue
+        std::size_t i = 0;
+        for (auto x = t; x != 1; x = multiply(x, x, _ctx)) {
+            i += 1;
+            if (i >= m) {
+                return 0_bn;
+            }
+        }
+
+        /// b = c^(2^(m - i - 1)) and b^2 are both entries of the table
+        r = multiply(r, _c_powers[_s - i - 1], _ctx);
+        t = multiply(t, _c_powers[_s - i], _ctx);
+        m = i;
+    }
+    return r;
+}
+
+BigNum SqrtContext::_atkin(const BigNum& num) const {
+    /// b = (2a)^((p - 5) / 8), i = 2a * b^2 is a square root of -1, x = a * b * (i - 1)
+    const auto doubled = add(num, num, _ctx);
+    const auto b = _ctx.pow(doubled, _shortcut_exponent);
+    const auto i = multiply(doubled, multiply(b, b, _ctx), _ctx);
+    return multiply(multiply(num, b, _ctx), subtract(i, 1_bn, _ctx), _ctx);
+}
+
+BigNum SqrtContext::_cipolla(const BigNum& num) const {
+    const auto& p = _ctx.modulo();
+
+    /// t such that w = t^2 - num is a non-residue, then (t + sqrt(w))^((p + 1) / 2) = sqrt(num)
+    BigNum t = 1_bn;
+    BigNum w = subtract(1_bn, num, _ctx);
+    while (t < p && _isResidue(w)) {
+        if (w == 0) {
+            return t;
+        }
+        t += 1;
+        w = subtract(multiply(t, t, _ctx), num, _ctx);
+    }
+
+    /// (x1 + y1 sqrt(w)) * (x2 + y2 sqrt(w)) = x1 x2 + y1 y2 w + (x1 y2 + x2 y1) sqrt(w)
+    const auto multiplyPairs = [this, &w](const std::pair<BigNum, BigNum>& left, const std::pair<BigNum, BigNum>& right) {
+        const auto& [x1, y1] = left;
+        const auto& [x2, y2] = right;
+        return std::pair{add(multiply(x1, x2, _ctx), multiply(multiply(y1, y2, _ctx), w, _ctx), _ctx),
+                         add(multiply(x1, y2, _ctx), multiply(x2, y1, _ctx), _ctx)};
+    };
+
+    const auto degree = toWords((p + 1) >> 1);
+    const std::pair base{t, 1_bn};
+    std::pair result{1_bn, 0_bn};
+    for (std::size_t bit = degree.size() * 64; bit-- > 0;) {
+        result = multiplyPairs(result, result);
+        if ((degree[bit / 64] >> (bit % 64)) & 1) {
+            result = multiplyPairs(result, base);
+        }
+    }
+    return result.first;
+}
+
+bool SqrtContext::_isResidue(const BigNum& num) const {
+    if (isOdd(_ctx.modulo())) {
+        return jacobi(num, _ctx.modulo()) != -1;
+    }
+    return _ctx.pow(num, _euler_exponent) != _ctx.modulo() - 1;
+}
+
+namespace {
+    /**
+     * @return Some element whose power (p - 1) / r isn't one, it is found in r / (r - 1) attempts on average
+     */
+    BigNum findNonResidue(const BigNum& cofactor, const Modulus& ctx) {
+        for (BigNum candidate = 2_bn; candidate < ctx.modulo(); candidate += 1) {
+            if (ctx.pow(candidate, cofactor) != 1) {
+                return candidate;
+            }
+        }
+        return 0_bn;
+    }
+
+    /**
+     * @brief Trial division, it is cheap next to the linear search over roots of unity of the same degree
+     */
+    bool isPrimeDegree(uint64_t degree) {
+        if (degree < 2) {
+            return false;
+        }
+        for (uint64_t divisor = 2; divisor <= degree / divisor; divisor++) {
+            if (degree % divisor == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+} // <anonymous> namespace
+
+std::optional<BigNum> rootMod(const BigNum& num, uint64_t degree, const Modulus& ctx) {
+    if (degree == 0) {
+        throw std::invalid_argument("Root degree must be positive");
+    }
+    if (degree != 1 && !isPrimeDegree(degree)) {
+        throw std::invalid_argument("Root degree must be prime");
+    }
+    const auto& p = ctx.modulo();
+    const auto a = ctx.reduce(num);
+    if (degree == 1 || a == 0 || a == 1) {
+        return a;
+    }
+    if (degree == 2) {
+        if (const auto roots = sqrt(a, ctx)) {
+            return roots->first;
+        }
+        return {};
+    }
+
+    const BigNum r(degree);
+    const auto order = p - 1;
+    const auto verified = [&](BigNum root) -> std::optional<BigNum> {
+        if (ctx.pow(root, r) != a) {
+            return {};
+        }
+        return root;
+    };
+
+    /// x -> x^r is a bijection, its inverse is power r^(-1) mod (p - 1)
+    if (order % degree != 0) {
+        return verified(ctx.pow(a, inverted(r, order, BigNum::InversionPolicy::Euclid)));
+    }
+
+    /// p - 1 = r^t * s with s coprime to r
+    BigNum s = order;
+    BigNum sylow_order = 1_bn;
+    std::size_t t = 0;
+    while (s % degree == 0) {
+        s = s / r;
+        sylow_order *= r;
+        t += 1;
+    }
+
+    /// Residues have a^((p - 1) / r) = 1
+    if (ctx.pow(a, order / r) != 1) {
+        return {};
+    }
+
+    /// x = a^alpha with r * alpha = 1 (mod s) gives x^r = a * e, where e lies in subgroup of order r^t.
+    /// For t = 1 residues have e = 1 already, which is the fast path
+    const auto alpha = s == 1 ? 0_bn : inverted(r % s, s, BigNum::InversionPolicy::Euclid);
+    auto x = ctx.pow(a, alpha);
+    const auto e = ctx.pow(a, multiply(r, alpha, order) + order - 1);
+    if (e == 1) {
+        return verified(std::move(x));
+    }
+
+    /// c = rho^s generates subgroup of order r^t, e = c^m is found digit by digit in base r (Pohlig–Hellman),
+    /// each digit is looked up among powers of gamma = c^(r^(t - 1)), which has order r
+    const auto c = ctx.pow(findNonResidue(order / r, ctx), s);
+    const auto c_inverse = ctx.pow(c, sylow_order - 1);
+    const auto gamma = ctx.pow(c, sylow_order / r);
+
+    BigNum m = 0_bn;
+    BigNum digit_weight = 1_bn;
+    BigNum rest_exponent = sylow_order / r;
+    for (std::size_t i = 0; i < t; i++) {
+        const auto h = ctx.pow(multiply(e, ctx.pow(c_inverse, m), ctx), rest_exponent);
+        BigNum digit = 0_bn;
+        for (BigNum gamma_power = 1_bn; gamma_power != h; gamma_power = multiply(gamma_power, gamma, ctx)) {
+            digit += 1;
+            if (digit == r) {
+                return {};
+            }
+        }
+        m += digit * digit_weight;
+        digit_weight *= r;
+        if (i + 1 < t) {
+            rest_exponent = rest_exponent / r;
+        }
+    }
+
+    /// m is divisible by r for residues, y = c^(-m / r) has y^r = e^(-1)
+    const auto [quotient, remainder] = extract(m, r);
+    if (remainder != 0) {
+        return {};
+    }
+    return verified(multiply(x, ctx.pow(c_inverse, quotient), ctx));
+}
+
+std::optional<BigNum> rootMod(const BigNum& num, uint64_t degree, const BigNum& mod) {
+    return rootMod(num, degree, Modulus(mod));
+}
+
+std::optional<BigNum> rootOfUnity(uint64_t degree, const Modulus& ctx) {
+    const auto order = ctx.modulo() - 1;
+    if (degree == 0 || order % degree != 0) {
+        return {};
+    }
+    if (degree == 1) {
+        return 1_bn;
+    }
+    const auto cofactor = order / BigNum(degree);
+    return ctx.pow(findNonResidue(cofactor, ctx), cofactor);
+}
+
+void addMod(BigNum& out, const BigNum& first, const BigNum& second, const Modulus& ctx) {
+    addModWith(out, first, second, ctx);
+}
+
+void subMod(BigNum& out, const BigNum& first, const BigNum& second, const Modulus& ctx) {
+    subModWith(out, first, second, ctx);
+}
+
+void mulMod(BigNum& out, const BigNum& lhs, const BigNum& rhs, const Modulus& ctx) {
+    mulModWith(out, lhs, rhs, ctx);
+}
+
+void sqrMod(BigNum& out, const BigNum& num, const Modulus& ctx) {
+    mulModWith(out, num, num, ctx);
+}
+
+} // namespace lab
@@ -0,0 +1,395 @@
+#pragma once
+
+#include "BigNum.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace lab {
+
+/**
+ * @brief Context for repeated reduction by the same modulus using Barrett's method.
+ *        Precomputes mu = NUM_BASE^(2k) / mod once, where k is the count of cells in mod,
+ *        so every reduction is two multiplications and a couple of subtractions
+ * @note Works for any modulus, including even ones
+ */
+class BarrettReducer
+{
+public:
+    BarrettReducer() = default;
+
+    explicit BarrettReducer(const BigNum& mod);
+
+    const BigNum& modulo() const noexcept;
+
+    /**
+     * @return num % modulo
+     * @note Numbers longer than 2k cells fall back to long division
+     */
+    BigNum reduce(const BigNum& num) const;
+
+    /**
+     * @brief Replaces num with num % modulo reusing its cells
+     */
+    void reduceInPlace(BigNum& num) const;
+
+    friend bool operator==(const BarrettReducer& left, const BarrettReducer& right) noexcept;
+    friend bool operator!=(const BarrettReducer& left, const BarrettReducer& right) noexcept;
+
+private:
+    BigNum _mod;
+    /// NUM_BASE^(2k) / mod
+    BigNum _mu;
+    /// NUM_BASE^(k+1)
+    BigNum _base_power;
+    /// Count of cells in mod
+    std::size_t _k = 0;
+};
+
+/**
+ * @brief Sliding-window recoding of fixed exponent, computed once and replayed for every base.
+ *        Degree is split into odd windows of at most width() bits separated by zero bits,
+ *        so exponentiation takes one multiplication per window instead of one per nonzero bit
+ * @note Inversion exponent p - 2 of pseudo-Mersenne primes is almost all ones, for secp256k1
+ *       it takes 318 multiplications with squarings and precomputation instead of 503 by binary method
+ */
+class ExponentRecoding
+{
+public:
+    ExponentRecoding() = default;
+
+    explicit ExponentRecoding(const BigNum& degree);
+
+    /**
+     * @brief Width of window chosen by bit length of degree, table of odd powers has 2^(width - 1) entries at most
+     */
+    std::size_t width() const noexcept;
+
+    /**
+     * @return Count of multiplications made by power(), precomputation included
+     */
+    std::size_t multiplications() const noexcept;
+
+    /**
+     * @brief Replays the recoding with given field operations
+     * @param sqr, mul Callables sqr(out, x) and mul(out, x, y) writing result into out, which never aliases operands,
+     *        so the two buffers swapped between steps keep their storage
+     */
+    template <typename Element, typename Square, typename Multiply>
+    Element power(const Element& base, const Element& one, Square&& sqr, Multiply&& mul) const {
+        Element result = one;
+        Element buffer = one;
+        std::vector<Element> odd_powers;
+        power(result, base, one, odd_powers, buffer, sqr, mul);
+        return result;
+    }
+
+    /**
+     * @brief Same as above with storage owned by caller, once odd_powers, buffer and result have grown
+     *        repeated calls with the same recoding allocate nothing
+     * @note result must not alias base
+     */
+    template <typename Element, typename Square, typename Multiply>
+    void power(Element& result, const Element& base, const Element& one,
+               std::vector<Element>& odd_powers, Element& buffer, Square&& sqr, Multiply&& mul) const {
+        if (_steps.empty()) {
+            result = one;
+            return;
+        }
+
+        /// base^1, base^3, ..., base^(2 * _table_size - 1)
+        odd_powers.resize(_table_size);
+        odd_powers[0] = base;
+        if (_table_size > 1) {
+            sqr(buffer, base);
+            for (std::size_t i = 1; i < _table_size; i++) {
+                mul(odd_powers[i], odd_powers[i - 1], buffer);
+            }
+        }
+
+        using std::swap;
+        result = odd_powers[_steps.front().odd_index];
+        const auto square = [&] {
+            sqr(buffer, result);
+            swap(result, buffer);
+        };
+        for (std::size_t i = 1; i < _steps.size(); i++) {
+            for (std::size_t j = 0; j < _steps[i].squarings; j++) {
+                square();
+            }
+            mul(buffer, result, odd_powers[_steps[i].odd_index]);
+            swap(result, buffer);
+        }
+        for (std::size_t j = 0; j < _trailing_squarings; j++) {
+            square();
+        }
+    }
+
+private:
+    struct Step {
+        /// Squarings made before multiplication
+        std::size_t squarings;
+        /// Multiplier is base^(2 * odd_index + 1)
+        std::size_t odd_index;
+    };
+
+    std::vector<Step> _steps;
+    std::size_t _trailing_squarings = 0;
+    std::size_t _table_size = 0;
+    std::size_t _width = 1;
+};
+
+/**
+ * @brief Shapes of modulus that allow reduction with shifts and additions only
+ */
+enum class ModulusForm {
+    /// Any modulus, reduced by Barrett's method
+    Generic,
+    /// 2^n - c, where c fits into a machine word and is much smaller than 2^n (2^255 - 19, secp256k1)
+    PseudoMersenne,
+    /// 2^n - d, where d has few nonzero signed binary digits (NIST primes)
+    Solinas
+};
+
+/**
+ * @brief Reduction context which recognizes special form of the modulus
+ *        and dispatches to the dedicated reduction routine, Barrett's method is used otherwise
+ */
+class Modulus
+{
+public:
+    Modulus() = default;
+
+    /**
+     * @brief Detects form of mod, pseudo-Mersenne form is preferred over Solinas one
+     */
+    explicit Modulus(const BigNum& mod);
+
+    /**
+     * @brief Uses declared form of mod
+     * @throw std::invalid_argument if mod doesn't have such form
+     */
+    Modulus(const BigNum& mod, ModulusForm form);
+
+    const BigNum& modulo() const noexcept;
+
+    ModulusForm form() const noexcept;
+
+    /**
+     * @return c = 2^n - modulo for pseudo-Mersenne form, zero for other forms
+     */
+    uint64_t pseudoMersenneConstant() const noexcept;
+
+    /**
+     * @return num % modulo
+     */
+    BigNum reduce(const BigNum& num) const;
+
+    /**
+     * @brief Replaces num with num % modulo reusing its cells
+     */
+    void reduceInPlace(BigNum& num) const;
+
+    /**
+     * @brief Reduces number given as little-endian 64-bit words in place
+     *        with the routine matching the form of modulo
+     */
+    void reduce(std::vector<uint64_t>& words) const;
+
+    /**
+     * @brief Modular exponentiation, special forms keep all intermediate values binary
+     *        and reduce them with shifts and additions only
+     */
+    BigNum pow(const BigNum& base, const BigNum& degree) const;
+
+    /**
+     * @brief Exponentiation replaying precomputed recoding of degree
+     */
+    BigNum pow(const BigNum& base, const ExponentRecoding& degree) const;
+
+    /**
+     * @brief Same as above written into @a out, tables and buffers are kept by the calling thread,
+     *        so repeated calls on moduli of the same size allocate nothing
+     * @note out must not alias base
+     */
+    void pow(BigNum& out, const BigNum& base, const ExponentRecoding& degree) const;
+
+    /**
+     * @brief Recoding of p - 2 used by Fermat's inversion, built with the context
+     * @note Reference lives as long as the context, so it isn't given out by temporaries
+     */
+    const ExponentRecoding& inversionExponent() const& noexcept;
+    const ExponentRecoding& inversionExponent() const&& = delete;
+
+    friend bool operator==(const Modulus& left, const Modulus& right) noexcept;
+    friend bool operator!=(const Modulus& left, const Modulus& right) noexcept;
+
+private:
+    /**
+     * @brief Buffers kept between reductions of words, so long computations stop allocating after first steps
+     */
+    struct Scratch {
+        std::vector<uint64_t> high;
+        std::vector<uint64_t> product;
+    };
+
+    void _reduce(std::vector<uint64_t>& words, Scratch& scratch) const;
+    void _foldPseudoMersenne(std::vector<uint64_t>& words, Scratch& scratch) const;
+    void _foldSolinas(std::vector<uint64_t>& words, Scratch& scratch) const;
+
+    BarrettReducer _barrett;
+    ModulusForm _form = ModulusForm::Generic;
+    /// Binary representation of modulo
+    std::vector<uint64_t> _words;
+    /// Bit length n of modulo
+    std::size_t _bits = 0;
+    /// c = 2^n - mod for pseudo-Mersenne form
+    uint64_t _c = 0;
+    /// Signed binary digits of d = 2^n - mod for Solinas form, pairs of exponent and sign
+    std::vector<std::pair<std::size_t, int>> _terms;
+    ExponentRecoding _inversion_exponent;
+};
+
+/**
+ * @brief Converts number to a corresponding in group modulo ctx.modulo()
+ */
+void modify(BigNum& num, const BarrettReducer& ctx);
+
+/**
+ * @brief Modulo addition
+ */
+BigNum add(const BigNum& first, const BigNum& second, const BarrettReducer& ctx);
+
+/**
+ * @brief Modulo subtraction
+ */
+BigNum subtract(const BigNum& first, const BigNum& second, const BarrettReducer& ctx);
+
+/**
+ * @brief Modulo multiplication
+ */
+BigNum multiply(const BigNum& lhs, const BigNum& rhs, const BarrettReducer& ctx);
+
+/**
+ * @brief Modular exponentiation, every step is reduced with ctx
+ */
+BigNum pow(const BigNum& base, const BigNum& degree, const BarrettReducer& ctx);
+
+/**
+ * @brief Return inverted number to num in group modulo ctx.modulo()
+ */
+BigNum inverted(const BigNum& num, const BarrettReducer& ctx, BigNum::InversionPolicy policy);
+
+void modify(BigNum& num, const Modulus& ctx);
+BigNum add(const BigNum& first, const BigNum& second, const Modulus& ctx);
+BigNum subtract(const BigNum& first, const BigNum& second, const Modulus& ctx);
+BigNum multiply(const BigNum& lhs, const BigNum& rhs, const Modulus& ctx);
+BigNum pow(const BigNum& base, const BigNum& degree, const Modulus& ctx);
+BigNum inverted(const BigNum& num, const Modulus& ctx, BigNum::InversionPolicy policy);
+
+/**
+ * @brief Square root modulo prime ctx.modulo(), residue and its negation are returned
+ * @note Goes through SqrtContext::cached(), so repeated calls with one modulo share precomputation
+ *       and the caller's context is copied only when the modulo is met first
+ */
+std::optional<std::pair<BigNum, BigNum>> sqrt(const BigNum& num, const Modulus& ctx);
+
+enum class SqrtMethod {
+    /// One exponentiation for p = 3 (mod 4), Atkin's formula for p = 5 (mod 8), Tonelli–Shanks otherwise
+    Auto,
+    TonelliShanks,
+    /// Exponentiation in F_p[sqrt(t^2 - num)], cost doesn't depend on power of two in p - 1
+    Cipolla
+};
+
+/**
+ * @brief Square roots modulo fixed odd prime p. Everything that depends on p only is computed once:
+ *        p - 1 = q * 2^s, exponents, the smallest non-residue z and table of c^(2^j) for c = z^q,
+ *        so Tonelli–Shanks takes no extra squarings to find its multipliers even for large s
+ */
+class SqrtContext
+{
+public:
+    explicit SqrtContext(const Modulus& ctx);
+
+    /**
+     * @brief Count of contexts kept per thread by cached(), so code alternating between a few moduli doesn't rebuild them
+     */
+    static constexpr std::size_t CACHE_SIZE = 4;
+
+    /**
+     * @return Context for modulo of @a ctx, built from the caller's context on first use and shared afterwards
+     * @note Contexts are kept per thread, the least recently used one is dropped when cache is full.
+     *       Returned pointer keeps its context alive and bound to the same modulo after that
+     */
+    static std::shared_ptr<const SqrtContext> cached(const Modulus& ctx);
+
+    /**
+     * @brief Same as cached(const Modulus&), Modulus is built only if the context isn't cached yet
+     */
+    static std::shared_ptr<const SqrtContext> cached(const BigNum& mod);
+
+    const Modulus& modulus() const noexcept;
+
+    /**
+     * @return Square roots of num in order (x, p - x), nothing if num isn't a quadratic residue
+     */
+    std::optional<std::pair<BigNum, BigNum>> sqrt(const BigNum& num, SqrtMethod method = SqrtMethod::Auto) const;
+
+private:
+    BigNum _tonelliShanks(const BigNum& num) const;
+    BigNum _atkin(const BigNum& num) const;
+    BigNum _cipolla(const BigNum& num) const;
+
+    bool _isResidue(const BigNum& num) const;
+
+    Modulus _ctx;
+    /// p - 1 = q * 2^s with odd q
+    BigNum _q;
+    std::size_t _s = 0;
+    /// q, (q + 1) / 2 for Tonelli–Shanks, (p + 1) / 4 or (p - 5) / 8 for shortcuts
+    ExponentRecoding _q_exponent;
+    ExponentRecoding _half_q_exponent;
+    ExponentRecoding _shortcut_exponent;
+    /// (p - 1) / 2 for Euler's criterion
+    BigNum _euler_exponent;
+    /// c^(2^j) for j < s, where c = z^q
+    std::vector<BigNum> _c_powers;
+};
+
+/**
+ * @brief Root of prime degree r modulo prime p, the other roots differ by factors rootOfUnity(r)^i
+ * @note If r doesn't divide p - 1, e.g. cube roots for p = 2 (mod 3), the root is unique and takes
+ *       one exponentiation. Otherwise Adleman–Manders–Miller algorithm is used, which searches
+ *       discrete logarithms in group of order r linearly, so it is meant for small r
+ * @return Nothing if num isn't r-th power residue
+ * @throw std::invalid_argument if degree is zero or composite
+ */
+std::optional<BigNum> rootMod(const BigNum& num, uint64_t degree, const Modulus& ctx);
+std::optional<BigNum> rootMod(const BigNum& num, uint64_t degree, const BigNum& mod);
+
+/**
+ * @brief Primitive root of unity of prime degree r modulo prime p, e.g. cube root of unity for GLV endomorphism
+ * @return Nothing if r doesn't divide p - 1
+ */
+std::optional<BigNum> rootOfUnity(uint64_t degree, const Modulus& ctx);
+
+/**
+ * @brief Output-parameter modular arithmetic, result is written into @a out and its cells are reused
+ * @note out may be one of operands. Operands are expected in range [0, modulo),
+ *       subMod falls back to subtract() otherwise
+ */
+void addMod(BigNum& out, const BigNum& first, const BigNum& second, const BarrettReducer& ctx);
+void subMod(BigNum& out, const BigNum& first, const BigNum& second, const BarrettReducer& ctx);
+void mulMod(BigNum& out, const BigNum& lhs, const BigNum& rhs, const BarrettReducer& ctx);
+void sqrMod(BigNum& out, const BigNum& num, const BarrettReducer& ctx);
+
+void addMod(BigNum& out, const BigNum& first, const BigNum& second, const Modulus& ctx);
+void subMod(BigNum& out, const BigNum& first, const BigNum& second, const Modulus& ctx);
+void mulMod(BigNum& out, const BigNum& lhs, const BigNum& rhs, const Modulus& ctx);
+void sqrMod(BigNum& out, const BigNum& num, const Modulus& ctx);
+
+} // namespace lab
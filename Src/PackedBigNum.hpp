@@ -0,0 +1,68 @@
+#pragma once
+
+#include "BigNum.hpp"
+#include "SmallVector.hpp"
+
+#include <cstdint>
+#include <functional>
+
+namespace lab {
+
+/**
+ * @brief Storage form of BigNum for large tables: cells below NUM_BASE fit into 32 bits,
+ *        so they are packed twice as densely as in BigNum, and a 256-bit residue stays inline
+ * @note Has no arithmetic, numbers are packed on insertion and unpacked when used.
+ *       Equal numbers hash equally in both forms
+ */
+class PackedBigNum
+{
+public:
+    /**
+     * @brief Count of cells kept without heap allocation, 256-bit numbers take 9 cells
+     */
+    static constexpr std::size_t INLINE_CELLS = 9;
+
+    PackedBigNum() = default;
+
+    explicit PackedBigNum(const BigNum& num)
+        : _cells(num._digits.begin(), num._digits.end())
+    { }
+
+    BigNum unpack() const {
+        BigNum result;
+        result._digits.assign(_cells.begin(), _cells.end());
+        return result;
+    }
+
+    explicit operator BigNum() const {
+        return unpack();
+    }
+
+    friend bool operator==(const PackedBigNum& left, const PackedBigNum& right) noexcept {
+        return left._cells == right._cells;
+    }
+
+    friend bool operator!=(const PackedBigNum& left, const PackedBigNum& right) noexcept {
+        return !(left == right);
+    }
+
+    friend std::size_t hash(const PackedBigNum& num) noexcept {
+        return detail::hashCells(num._cells.data(), num._cells.size());
+    }
+
+private:
+    SmallVector<uint32_t, INLINE_CELLS> _cells;
+};
+
+std::size_t hash(const PackedBigNum& num) noexcept;
+
+} // namespace lab
+
+namespace std {
+template <>
+struct hash<lab::PackedBigNum> {
+    std::size_t operator()(const lab::PackedBigNum& num) const noexcept {
+        return lab::hash(num);
+    }
+};
+} // namespace std
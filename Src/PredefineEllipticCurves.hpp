@@ -1,6 +1,7 @@
 #pragma once
 
 #include "EllipticCurves.hpp"
+#include "FixedBigNum.hpp"
 #include <array>
 
 namespace lab {
@@ -10,30 +11,57 @@ struct FieldMeta {
     static constexpr int CURVES_PER_FIELED = 3;
     std::array<EllipticCurve, CURVES_PER_FIELED>  curves;
 };
-    
+
 /**
-* @brief Elliptic curves database with thier labels on https://www.lmfdb.org/EllipticCurve/Q/
+ * @brief Coefficients of y^2 = x^3 + a*x + b mod modulo
+ */
+struct CurveConstants {
+    FixedBigNum<64> modulo;
+    FixedBigNum<64> a;
+    FixedBigNum<64> b;
+};
+
+inline const int FIELD_NUMBER = 3;
+
+/**
+* @brief Numbers of curveDataBase with thier labels on https://www.lmfdb.org/EllipticCurve/Q/
 *        (paste label into a box near the big blue button)
+* @note The table is computed during compilation, so it is safe to read from other static initializers
 */
-inline const int FIELD_NUMBER = 3;
-inline const FieldMeta curveDataBase[] = {
-    {Field(234131_bn),
-        {EllipticCurve(new Field(234131_bn),228960_bn,91781_bn), //100016.g1
-         EllipticCurve(new Field(234131_bn),3133_bn,46606_bn), //100040.g1
-         EllipticCurve(new Field(234131_bn),227064_bn,9977_bn) //100040.g4
-        } 
-    }, 
-    {Field(80000005213_bn),
-        {EllipticCurve(new Field(80000005213_bn),39912548_bn,7610314_bn), //100016.h1
-         EllipticCurve(new Field(80000005213_bn),39796616_bn,38003178_bn), //100040.d2
-         EllipticCurve(new Field(80000005213_bn),79966658546_bn,74118524074_bn) //200080.q1
-        } 
+inline constexpr CurveConstants curveConstants[FIELD_NUMBER][FieldMeta::CURVES_PER_FIELED] = {
+    {{234131_fbn, 228960_fbn, 91781_fbn}, //100016.g1
+     {234131_fbn, 3133_fbn, 46606_fbn}, //100040.g1
+     {234131_fbn, 227064_fbn, 9977_fbn} //100040.g4
+    },
+    {{80000005213_fbn, 39912548_fbn, 7610314_fbn}, //100016.h1
+     {80000005213_fbn, 39796616_fbn, 38003178_fbn}, //100040.d2
+     {80000005213_fbn, 79966658546_fbn, 74118524074_fbn} //200080.q1
     },
-    {Field(773_bn),
-        {EllipticCurve(new Field(773_bn),761_bn,65_bn), //252.a2
-         EllipticCurve(new Field(773_bn),446_bn,724_bn), //252.a1
-         EllipticCurve(new Field(773_bn),761_bn,20_bn) //216.a1
-        }
+    {{773_fbn, 761_fbn, 65_fbn}, //252.a2
+     {773_fbn, 446_fbn, 724_fbn}, //252.a1
+     {773_fbn, 761_fbn, 20_fbn} //216.a1
     }
 };
+
+namespace detail {
+    inline EllipticCurve makeCurve(const CurveConstants& constants) {
+        return EllipticCurve(new Field(static_cast<BigNum>(constants.modulo)),
+                             static_cast<BigNum>(constants.a), static_cast<BigNum>(constants.b));
+    }
+
+    inline FieldMeta makeFieldMeta(const CurveConstants (&curves)[FieldMeta::CURVES_PER_FIELED]) {
+        return {Field(static_cast<BigNum>(curves[0].modulo)),
+                {makeCurve(curves[0]), makeCurve(curves[1]), makeCurve(curves[2])}};
+    }
+} // namespace detail
+
+/**
+* @brief Elliptic curves database built from curveConstants
+* @note Curves allocate their fields and reduction contexts, so the database itself is still initialized at load
+*/
+inline const FieldMeta curveDataBase[] = {
+    detail::makeFieldMeta(curveConstants[0]),
+    detail::makeFieldMeta(curveConstants[1]),
+    detail::makeFieldMeta(curveConstants[2])
+};
 } // namespace lab
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace lab {
+
+/**
+ * @brief Contiguous array which keeps up to N elements inside the object
+ *        and moves them to the heap only when it grows beyond that
+ * @note Only trivially copyable elements are supported, they are copied bytewise
+ *       and left uninitialized by reserve
+ */
+template <typename T, std::size_t N>
+class SmallVector
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SmallVector holds trivially copyable elements only");
+    static_assert(N > 0, "SmallVector needs inline capacity");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /**
+     * @brief Count of elements stored without allocation
+     */
+    static constexpr size_type INLINE_CAPACITY = N;
+
+    SmallVector() noexcept {}
+
+    SmallVector(size_type count, const T& value) {
+        assign(count, value);
+    }
+
+    template <typename InputIt,
+              typename = typename std::iterator_traits<InputIt>::iterator_category>
+    SmallVector(InputIt first, InputIt last) {
+        assign(first, last);
+    }
+
+    /**
+     * @brief Copies values known at compile time, constant-initializes when they fit inline
+     */
+    template <std::size_t M, std::enable_if_t<(M <= N), int> = 0>
+    constexpr explicit SmallVector(const std::array<T, M>& values) noexcept
+        : SmallVector(values, std::make_index_sequence<M>{})
+    { }
+
+    template <std::size_t M, std::enable_if_t<(M > N), int> = 0>
+    explicit SmallVector(const std::array<T, M>& values) {
+        assign(values.begin(), values.end());
+    }
+
+    SmallVector(std::initializer_list<T> init) {
+        assign(init.begin(), init.end());
+    }
+
+    SmallVector(const SmallVector& that) {
+        assign(that.begin(), that.end());
+    }
+
+    SmallVector(SmallVector&& that) noexcept {
+        _steal(that);
+    }
+
+    SmallVector& operator=(const SmallVector& that) {
+        if (this != &that) {
+            assign(that.begin(), that.end());
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& that) noexcept {
+        if (this != &that) {
+            delete[] _heap;
+            _heap = nullptr;
+            _capacity = N;
+            _steal(that);
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        delete[] _heap;
+    }
+
+    T* data() noexcept {
+        return _heap != nullptr ? _heap : _inline;
+    }
+
+    const T* data() const noexcept {
+        return _heap != nullptr ? _heap : _inline;
+    }
+
+    size_type size() const noexcept {
+        return _size;
+    }
+
+    size_type capacity() const noexcept {
+        return _capacity;
+    }
+
+    bool empty() const noexcept {
+        return _size == 0;
+    }
+
+    /**
+     * @return True if elements live inside the object
+     */
+    bool isInline() const noexcept {
+        return _heap == nullptr;
+    }
+
+    iterator begin() noexcept { return data(); }
+    iterator end() noexcept { return data() + _size; }
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return data() + _size; }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    T& operator[](size_type pos) noexcept {
+        return data()[pos];
+    }
+
+    const T& operator[](size_type pos) const noexcept {
+        return data()[pos];
+    }
+
+    T& front() noexcept { return data()[0]; }
+    const T& front() const noexcept { return data()[0]; }
+    T& back() noexcept { return data()[_size - 1]; }
+    const T& back() const noexcept { return data()[_size - 1]; }
+
+    /**
+     * @brief Makes room for @a count elements, existing ones are kept
+     */
+    void reserve(size_type count) {
+        if (count <= _capacity) {
+            return;
+        }
+        T* storage = new T[count];
+        std::copy(begin(), end(), storage);
+        delete[] _heap;
+        _heap = storage;
+        _capacity = count;
+    }
+
+    void resize(size_type count, const T& value = T()) {
+        if (count > _size) {
+            _grow(count);
+            std::fill(data() + _size, data() + count, value);
+        }
+        _size = count;
+    }
+
+    void assign(size_type count, const T& value) {
+        _size = 0;
+        resize(count, value);
+    }
+
+    template <typename InputIt,
+              typename = typename std::iterator_traits<InputIt>::iterator_category>
+    void assign(InputIt first, InputIt last) {
+        const auto count = static_cast<size_type>(std::distance(first, last));
+        _size = 0;
+        reserve(count);
+        std::copy(first, last, data());
+        _size = count;
+    }
+
+    void push_back(const T& value) {
+        if (_size == _capacity) {
+            /// value may refer to an element of this array
+            const T copy = value;
+            _grow(_size + 1);
+            data()[_size++] = copy;
+            return;
+        }
+        data()[_size++] = value;
+    }
+
+    void pop_back() noexcept {
+        --_size;
+    }
+
+    void clear() noexcept {
+        _size = 0;
+    }
+
+    void swap(SmallVector& that) noexcept {
+        SmallVector temp(std::move(that));
+        that = std::move(*this);
+        *this = std::move(temp);
+    }
+
+    friend bool operator==(const SmallVector& left, const SmallVector& right) noexcept {
+        /// Sizes are compared first, equal runs of integers are compared as memory
+        return left._size == right._size && std::equal(left.begin(), left.end(), right.begin());
+    }
+
+    friend bool operator!=(const SmallVector& left, const SmallVector& right) noexcept {
+        return !(left == right);
+    }
+
+private:
+    template <std::size_t M, std::size_t... I>
+    constexpr SmallVector(const std::array<T, M>& values, std::index_sequence<I...>) noexcept
+        : _heap(nullptr)
+        , _size(M)
+        , _capacity(N)
+        , _inline{values[I]...}
+    { }
+
+    /**
+     * @brief Reserves at least @a count elements, capacity is doubled to keep push_back amortized
+     */
+    void _grow(size_type count) {
+        if (count > _capacity) {
+            reserve(std::max(count, _capacity * 2));
+        }
+    }
+
+    /**
+     * @brief Takes elements of @a that, this must not own heap storage before the call
+     */
+    void _steal(SmallVector& that) noexcept {
+        if (that._heap != nullptr) {
+            _heap = std::exchange(that._heap, nullptr);
+            _capacity = std::exchange(that._capacity, N);
+        } else {
+            std::copy(that._inline, that._inline + that._size, _inline);
+        }
+        _size = std::exchange(that._size, 0);
+    }
+
+    /// Heap storage, nullptr while elements fit into _inline
+    T* _heap = nullptr;
+    size_type _size = 0;
+    size_type _capacity = N;
+    T _inline[N];
+};
+
+} // namespace lab
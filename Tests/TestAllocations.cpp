@@ -0,0 +1,69 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <CurveEngine.hpp>
+
+#include <cstdlib>
+#include <new>
+
+/// Global operator new is replaced for this executable only, so the main test binary keeps the default allocator
+namespace {
+    std::size_t allocations = 0;
+}
+
+void* operator new(std::size_t size) {
+    allocations += 1;
+    if (void* storage = std::malloc(size == 0 ? 1 : size)) {
+        return storage;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* storage) noexcept {
+    std::free(storage);
+}
+
+void operator delete[](void* storage) noexcept {
+    std::free(storage);
+}
+
+void operator delete(void* storage, std::size_t) noexcept {
+    std::free(storage);
+}
+
+void operator delete[](void* storage, std::size_t) noexcept {
+    std::free(storage);
+}
+
+TEST_CASE("Allocations test", "[allocations]") {
+    using namespace lab;
+
+    SECTION("Scalar multiplication reuses storage") {
+        /// Special form is inverted on binary words and generic one by Barrett's method
+        const auto modulo = 2305843009213693951_bn;
+        const std::vector<Modulus> moduli = {Modulus(modulo), Modulus(modulo, ModulusForm::Generic)};
+
+        for (const auto& mod : moduli) {
+            const BasicEllipticCurve<BigNumField> curve(BigNumField(mod), 1_bn, modulo - 1_bn);
+            const auto p = curve.makePoint(1_bn, 1_bn);
+            const auto countFor = [&](const BigNum& power) {
+                const auto before = allocations;
+                const auto result = curve.powerPoint(p, power);
+                const auto made = allocations - before;
+                REQUIRE(curve.contains(result));
+                return made;
+            };
+
+            /// Buffers of this thread grow during the first call, after that the count doesn't depend
+            /// on count of doublings and additions, each of which allocated before
+            countFor(modulo - 7_bn);
+            const auto short_power = countFor(1000003_bn);
+            const auto long_power = countFor(modulo - 7_bn);
+            REQUIRE(short_power == long_power);
+        }
+    }
+}
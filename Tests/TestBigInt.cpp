@@ -0,0 +1,90 @@
+#include <BigInt.hpp>
+
+#include "catch.hpp"
+
+#include <limits>
+
+TEST_CASE("Signed big numbers test", "[BigInt]") {
+    using namespace lab;
+
+    const BigInt big("123456789123456789123456789");
+    const BigInt small("-987654321");
+
+    SECTION("Construction") {
+        REQUIRE(to_string(BigInt(-42)) == "-42");
+        REQUIRE(to_string(BigInt(std::numeric_limits<int64_t>::min())) == "-9223372036854775808");
+        REQUIRE(to_string(small) == "-987654321");
+        REQUIRE(BigInt("-0") == BigInt(0));
+        REQUIRE_FALSE(BigInt(0_bn, true).isNegative());
+        REQUIRE(BigInt(5_bn, true) == BigInt(-5));
+        REQUIRE(small.magnitude() == 987654321_bn);
+        REQUIRE(small.sign() == -1);
+        REQUIRE(BigInt().sign() == 0);
+        REQUIRE(big.sign() == 1);
+    }
+
+    SECTION("Arithmetic") {
+        REQUIRE(big + small == BigInt("123456789123456788135802468"));
+        REQUIRE(small + big == BigInt("123456789123456788135802468"));
+        REQUIRE(small - big == BigInt("-123456789123456790111111110"));
+        REQUIRE(BigInt(5) - BigInt(7) == BigInt(-2));
+        REQUIRE(BigInt(-5) - BigInt(-7) == BigInt(2));
+        REQUIRE(BigInt(7) + BigInt(-7) == BigInt(0));
+        REQUIRE_FALSE((BigInt(7) + BigInt(-7)).isNegative());
+        REQUIRE(big * small == BigInt("-121932631234567900234567900112635269"));
+        REQUIRE(small * small == BigInt("975461057789971041"));
+        REQUIRE(-small == BigInt(987654321));
+        REQUIRE(-BigInt(0) == BigInt(0));
+
+        BigInt value = 10;
+        value -= 25;
+        REQUIRE(value == BigInt(-15));
+        value *= -2;
+        REQUIRE(value == BigInt(30));
+        value += -31;
+        REQUIRE(value == BigInt(-1));
+    }
+
+    SECTION("Division") {
+        REQUIRE(BigInt(7) / BigInt(2) == BigInt(3));
+        REQUIRE(BigInt(-7) / BigInt(2) == BigInt(-3));
+        REQUIRE(BigInt(-7) % BigInt(2) == BigInt(-1));
+        REQUIRE(BigInt(7) % BigInt(-2) == BigInt(1));
+
+        REQUIRE(divideFloored(BigInt(-7), BigInt(2)) == std::pair(BigInt(-4), BigInt(1)));
+        REQUIRE(divideFloored(BigInt(7), BigInt(-2)) == std::pair(BigInt(-4), BigInt(-1)));
+        REQUIRE(divideFloored(BigInt(-7), BigInt(-2)) == std::pair(BigInt(3), BigInt(-1)));
+        REQUIRE(divideFloored(BigInt(-8), BigInt(2)) == std::pair(BigInt(-4), BigInt(0)));
+        REQUIRE(divideTruncated(big, small) == std::pair(BigInt("-124999998985937499"), BigInt(173610)));
+        REQUIRE_THROWS_AS(BigInt(1) / BigInt(0), std::invalid_argument);
+
+        REQUIRE(residue(BigInt(-7), 5_bn) == 3_bn);
+        REQUIRE(residue(BigInt(-10), 5_bn) == 0_bn);
+        REQUIRE(residue(big, 1000_bn) == 789_bn);
+    }
+
+    SECTION("Comparison") {
+        REQUIRE(small < big);
+        REQUIRE(BigInt(-10) < BigInt(-9));
+        REQUIRE(BigInt(-1) < BigInt(0));
+        REQUIRE(BigInt(3) > BigInt(-3));
+        REQUIRE(BigInt(-3) <= BigInt(-3));
+        REQUIRE(BigInt(-3) >= BigInt(-4));
+        REQUIRE(BigInt(-3) != BigInt(3));
+    }
+
+    SECTION("Extended gcd") {
+        const auto check = [](const BigNum& a, const BigNum& b, const BigNum& expected) {
+            const auto [divisor, x, y] = extendedGcd(a, b);
+            REQUIRE(divisor == expected);
+            REQUIRE(BigInt(a) * x + BigInt(b) * y == BigInt(divisor));
+        };
+        check(240_bn, 46_bn, 2_bn);
+        check(46_bn, 240_bn, 2_bn);
+        check(17_bn, 0_bn, 17_bn);
+        check(0_bn, 17_bn, 17_bn);
+        check(1442141324241124_bn, 23321723123_bn, 1_bn);
+        check(115792089237316195423570985008687907853269984665640564039457584007908834671663_bn,
+              55066263022277343669578718895168534326250603453777594175500187360389116729240_bn, 1_bn);
+    }
+}
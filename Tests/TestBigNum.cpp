@@ -1,6 +1,7 @@
 #include <BigNum.hpp>
 
 #include <sstream>
+#include <unordered_map>
 
 #include "catch.hpp"
 
@@ -50,6 +51,106 @@ TEST_CASE("Big numbers test", "[BigNum]") {
         }
     }
 
+    SECTION( "Parsing in any base" ) {
+        const std::string decimal = "1005591935629511990300079928253988282159488380621595513651786959081482262762662814112586393088676987436836255883518357904724367084046668383673200245975752703845485716744944488377407718793882589536216854483987629650255102043499610294684975638284215193076463158885564740245623901540111798234854478514260887431266732404458248453207472756737619003451965431232207534844612644437662161972911916404459084423290812738592151094348480249376765398373527568160371699796246397708544843415003882453513935967068692588638226657352206781957461320481952334295370109909534874612851933912209713534589716079953880429712957113695893102971205191217915407125807265343966367544393264876102954144208223708325340429401046998221889150191216396678520215675126830277817822083219472048057174490823837938734052335813260928068078295129028289104268468212058086269253306514843712521579887793970299305533901615352897937999848568756179991621";
+        const std::string hex = "d141254d25deb354f46a6910acff0043892dfc254cb864ef901b932a7c18806a3753915c76f18a0585a01c4c7d6df0621aef57e4cc4132f7108e96f770c2263266aa3bb0cde917f7f35634f0e3cd972e81d66d346c6e2ba02fdaa1ad864c44e049548e8a0a8c9632ea6928f6236bf2504b74ba4a0fe75d2a9eba0cdf561d802a759159fb7ff337f5cae3bf3729c619c60a3cab359eeefb015c33b2df1461aaf8eb18b90074513021da8978206f5c6671e0c07e9e115e4b9e30691c238642ea126a1e48cc11d357c30d8b7628dbd25e63b229f1c4069545de11cc9dea959c212e9c82b1478c281d687c966c377b9aa2bb2edb20035b73993fd4235992edcf451a1afe878b33e968617959ce3f1f65a8de5271007814e8a25f2dd97f1cfb10f62827688de6a16a3b0d464138a62332553fc1ea36f17fd374c6a5387777330bdbd7210dff076ce2ef87b0b125ec1d7da0a6eb8c9ebd69fe29d76d4330f1446beab0c11fdecb91ce375bc8fbbcbde5c0994164d8399f767c45";
+        const std::string binary = "110100010100000100100101010011010010010111011110101100110101010011110100011010100110100100010000101011001111111100000000010000111000100100101101111111000010010101001100101110000110010011101111100100000001101110010011001010100111110000011000100000000110101000110111010100111001000101011100011101101111000110001010000001011000010110100000000111000100110001111101011011011111000001100010000110101110111101010111111001001100110001000001001100101111011100010000100011101001011011110111011100001100001000100110001100100110011010101010001110111011000011001101111010010001011111110111111100110101011000110100111100001110001111001101100101110010111010000001110101100110110100110100011011000110111000101011101000000010111111011010101000011010110110000110010011000100010011100000010010010101010010001110100010100000101010001100100101100011001011101010011010010010100011110110001000110110101111110010010100000100101101110100101110100100101000001111111001110101110100101010100111101011101000001100110111110101011000011101100000000010101001110101100100010101100111111011011111111111001100110111111101011100101011100011101111110011011100101001110001100001100111000110000010100011110010101011001101011001111011101110111110110000000101011100001100111011001011011111000101000110000110101010111110001110101100011000101110010000000001110100010100010011000000100001110110101000100101111000001000000110111101011100011001100111000111100000110000000111111010011110000100010101111001001011100111100011000001101001000111000010001110000110010000101110101000010010011010100001111001001000110011000001000111010011010101111100001100001101100010110111011000101000110110111101001001011110011000111011001000101001111100011100010000000110100101010100010111011110000100011100110010011101111010101001010110011100001000010010111010011100100000101011000101000111100011000010100000011101011010000111110010010110011011000011011101111011100110101010001010111011001011101101101100100000000000110101101101110011100110010011111111010100001000110101100110010010111011011100111101000101000110100001101011111110100001111000101100110011111010010110100001100001011110010101100111001110001111110001111101100101101010001101111001010010011100010000000001111000000101001110100010100010010111110010110111011001011111110001110011111011000100001111011000101000001001110110100010001101111001101010000101101010001110110000110101000110010000010011100010100110001000110011001001010101001111111100000111101010001101101111000101111111110100110111010011000110101001010011100001110111011101110011001100001011110110111101011100100001000011011111111100000111011011001110001011101111100001111011000010110001001001011110110000011101011111011010000010100110111010111000110010011110101111010110100111111110001010011101011101101101010000110011000011110001010001000110101111101010101100001100000100011111110111101100101110010001110011100011011101011011110010001111101110111100101111011110010111000000100110010100000101100100110110000011100110011111011101100111110001000101";
+        const std::string octal = "6424044523222736546523643246442053177400207044557702251456062357440156231247603040065067247105343557061201302640070461753337014206567527711461011457342043513367341410461446325216730315722137677465306474161715456272016546646433067053500277325032660623042340222522164240521445431352322243661066576224045564564450177165645247535014676530354002516544254773377714677534534357633451614147060243625315317356766005341473133705060652761654305620016424230041665045701006753431470740600772360425711347430151070216062056502232417110630107232574141542673050667511363073105174342006452427360434623572512634102272344053050743024035320762263303357346521273135554400065556346237724106546227334750506415376417054637226414136254716176175455215712234200170051642422762673137616373041730501166421571520552166065062023424610631125177407521557057764672306512341673563141366753441033774073316135741730261113660353732024672706236572647761235355520630361210657525414043767545621634335336217567457362700462405446603463735476105";
+        const BigNum expected(decimal);
+        const auto parse = [](const std::string& digits, int base) {
+            return lab::fromChars(digits.data(), digits.data() + digits.size(), base);
+        };
+
+        REQUIRE(parse(decimal, 10) == expected);
+        REQUIRE(parse(hex, 16) == expected);
+        REQUIRE(parse(binary, 2) == expected);
+        REQUIRE(parse(octal, 8) == expected);
+        REQUIRE(parse("FfFfFfFfFfFfFfFf", 16) == 18446744073709551615_bn);
+        REQUIRE(parse("zz", 36) == 1295_bn);
+        REQUIRE(parse("000000000000000000000000000000000000000000101", 2) == 5_bn);
+        REQUIRE(parse("0", 16) == 0_bn);
+        REQUIRE(parse("0000000000000000000000000000000000000000000001", 10) == 1_bn);
+
+        REQUIRE_THROWS_AS(parse("12", 1), std::invalid_argument);
+        REQUIRE_THROWS_AS(parse("12", 37), std::invalid_argument);
+        REQUIRE_THROWS_AS(parse("", 10), std::invalid_argument);
+        REQUIRE_THROWS_AS(parse("102", 2), std::invalid_argument);
+        REQUIRE_THROWS_AS(parse("12a", 10), std::invalid_argument);
+        REQUIRE_THROWS_AS(parse("-1", 10), std::invalid_argument);
+    }
+
+    SECTION( "Printing in any base" ) {
+        const auto print = [](const BigNum& num, int base) {
+            std::string text(maxChars(num, base), ' ');
+            const auto end = toChars(text.data(), text.data() + text.size(), num, base);
+            return std::string(text.data(), end);
+        };
+        const auto big = 1000000000000000000000000000000000000000000000000000000000000000000000000000000007_bn;
+
+        REQUIRE(print(big, 10) == to_string(big));
+        REQUIRE(print(1000000000000000000000000000000000000000000000000000000000000000000000000000000007_bn, 10).size() == 82);
+        REQUIRE(print(0_bn, 10) == "0");
+        REQUIRE(print(0_bn, 2) == "0");
+        REQUIRE(print(18446744073709551615_bn, 16) == "ffffffffffffffff");
+        REQUIRE(print(18446744073709551616_bn, 16) == "10000000000000000");
+        REQUIRE(print(1295_bn, 36) == "zz");
+        REQUIRE(print(5_bn, 2) == "101");
+        REQUIRE(print((1_bn << 1000) + 1, 2) == "1" + std::string(999, '0') + "1");
+
+        for (int base : {2, 3, 8, 16, 36}) {
+            const auto text = print(big * big * big, base);
+            REQUIRE(text.size() <= maxChars(big * big * big, base));
+            REQUIRE(fromChars(text.data(), text.data() + text.size(), base) == big * big * big);
+        }
+
+        /// Powers cached for the long number must not disturb short ones
+        REQUIRE(print(255_bn, 16) == "ff");
+        REQUIRE(fromChars("ff", "ff" + 2, 16) == 255_bn);
+
+        REQUIRE(maxChars(5_bn, 10) == 1);
+        REQUIRE(maxChars(0_bn, 10) == 1);
+        REQUIRE(maxChars(big, 10) == 82);
+        REQUIRE(maxChars(1000000000_bn, 10) == 10);
+
+        char small[3];
+        REQUIRE_THROWS_AS(toChars(small, small + 3, 1000_bn), std::invalid_argument);
+        REQUIRE_THROWS_AS(toChars(small, small + 3, 16_bn, 2), std::invalid_argument);
+        REQUIRE_THROWS_AS(toChars(small, small + 3, 1_bn, 37), std::invalid_argument);
+        REQUIRE(toChars(small, small + 3, 999_bn) == small + 3);
+    }
+
+    SECTION( "Bytes" ) {
+        const auto p256 = 115792089210356248762697446949407573530086143415290314195533631308867097853951_bn;
+        std::byte big[32];
+        std::byte little[32];
+        toBytes(p256, big, sizeof(big), Endian::Big);
+        toBytes(p256, little, sizeof(little), Endian::Little);
+        REQUIRE(big[0] == std::byte{0xFF});
+        REQUIRE(big[31] == std::byte{0xFF});
+        REQUIRE(big[4] == std::byte{0x00});
+        REQUIRE(big[7] == std::byte{0x01});
+        REQUIRE(little[24] == std::byte{0x01});
+        REQUIRE(fromBytes(big, sizeof(big), Endian::Big) == p256);
+        REQUIRE(fromBytes(little, sizeof(little), Endian::Little) == p256);
+        REQUIRE(byteLength(p256) == 32);
+
+        std::byte padded[5];
+        toBytes(258_bn, padded, sizeof(padded), Endian::Big);
+        REQUIRE(padded[0] == std::byte{0});
+        REQUIRE(padded[3] == std::byte{1});
+        REQUIRE(padded[4] == std::byte{2});
+        REQUIRE(fromBytes(padded, sizeof(padded), Endian::Big) == 258_bn);
+        REQUIRE(fromBytes(padded, sizeof(padded), Endian::Little) == 8606711808_bn);
+
+        REQUIRE(byteLength(0_bn) == 0);
+        REQUIRE(byteLength(255_bn) == 1);
+        REQUIRE(byteLength(256_bn) == 2);
+        REQUIRE(fromBytes(nullptr, 0, Endian::Big) == 0_bn);
+        toBytes(0_bn, padded, 0, Endian::Big);
+        REQUIRE_THROWS_AS(toBytes(256_bn, padded, 1, Endian::Little), std::invalid_argument);
+        REQUIRE_THROWS_AS(toBytes(p256, big, 31, Endian::Big), std::invalid_argument);
+    }
+
     SECTION( "Add BigNum" ) {
         const BigNum mod("666666666666");
 
@@ -182,6 +283,40 @@ TEST_CASE("Big numbers test", "[BigNum]") {
         }
     }
 
+    SECTION( "Three-way comparison" ) {
+        REQUIRE(compare(1000000000_bn, 999999999_bn) > 0);
+        REQUIRE(compare(999999999_bn, 1000000000_bn) < 0);
+        REQUIRE(compare(123456789123456789_bn, 123456789123456789_bn) == 0);
+        REQUIRE(compare(123456789123456789_bn, 123456789123456788_bn) > 0);
+        REQUIRE(compare(223456789123456788_bn, 123456789123456789_bn) > 0);
+        REQUIRE(compare(0_bn, 0_bn) == 0);
+        REQUIRE(123456789123456789_bn != 123456789023456789_bn);
+        REQUIRE(1000000000_bn != 1_bn);
+    }
+
+    SECTION( "Hashing" ) {
+        const auto num = 123456789123456789123456789_bn;
+        REQUIRE(hash(num) == hash(123456789123456789123456789_bn));
+        REQUIRE(std::hash<BigNum>{}(num) == hash(num));
+        REQUIRE(hash(num) != hash(num + 1));
+        REQUIRE(hash(1000000000_bn) != hash(1_bn));
+        REQUIRE(hash(1000000000_bn) != hash(0_bn));
+        REQUIRE(hashLowCell(num) == hashLowCell(123456789_bn));
+        REQUIRE(hashLowCell(num) != hashLowCell(123456788_bn));
+
+        std::unordered_map<BigNum, int> table;
+        for (int i = 0; i < 1000; ++i) {
+            table[(num << i) + 1] = i;
+        }
+        REQUIRE(table.size() == 1000);
+        REQUIRE(table.at((num << 500) + 1) == 500);
+
+        std::unordered_map<BigNum, int, LowCellHash> residues;
+        residues[num] = 1;
+        REQUIRE(residues.count(123456789123456789123456789_bn) == 1);
+        REQUIRE(residues.count(789_bn) == 0);
+    }
+
     SECTION( "Copy" ) {
         SECTION( "test" ) {
             const BigNum a("1234567890");
@@ -250,6 +385,148 @@ TEST_CASE("Big numbers test", "[BigNum]") {
         }
     }
 
+    SECTION( "Carries" ) {
+        REQUIRE(999999999_bn + 1000000000999999999_bn == 1000000001999999998_bn);
+        REQUIRE(999999999999999999999999999_bn + 1_bn == 1000000000000000000000000000_bn);
+        REQUIRE(1000000000000000000000000000_bn - 1_bn == 999999999999999999999999999_bn);
+        REQUIRE(1000000000000000000_bn - 1000000000000000000_bn == 0_bn);
+    }
+
+    SECTION( "Literals" ) {
+        static_assert(detail::DecimalLiteral<'1', '2', '3', '4', '5', '6', '7', '8', '9', '0'>::CELLS[0] == 234567890);
+        static_assert(detail::DecimalLiteral<'0', '0', '0'>::SIZE == 1);
+
+        REQUIRE(to_string(0_bn) == "0");
+        REQUIRE(000123_bn == 123_bn);
+        REQUIRE(1'000'000'000_bn == BigNum("1000000000"));
+
+        const std::string long_num = "1234567890" + std::string(200, '7');
+        REQUIRE(to_string(123456789077777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777_bn) == long_num);
+    }
+
+    SECTION( "Compound assignment" ) {
+        auto num = 999999999999999999_bn;
+        num += 1_bn;
+        REQUIRE(num == 1000000000000000000_bn);
+        num -= 999999999999999999_bn;
+        REQUIRE(num == 1_bn);
+        num += num;
+        REQUIRE(num == 2_bn);
+        num *= 123456789123456789_bn;
+        REQUIRE(num == 246913578246913578_bn);
+        num /= 1000000000_bn;
+        REQUIRE(num == 246913578_bn);
+        num %= 1000_bn;
+        REQUIRE(num == 578_bn);
+        num += 1000000000;
+        num -= 578;
+        REQUIRE(num == 1000000000_bn);
+        num -= num;
+        REQUIRE(num == 0_bn);
+    }
+
+    SECTION( "Temporaries and swap" ) {
+        const auto a = 123456789123456789123_bn;
+        REQUIRE(a * 2_bn + a == 370370367370370367369_bn);
+        REQUIRE(a + a * 2_bn == 370370367370370367369_bn);
+        REQUIRE(a * 2_bn + a * 2_bn == 493827156493827156492_bn);
+        REQUIRE(a * 2_bn - a == a);
+        REQUIRE(a * 2_bn + 1 - 1 == a + a);
+
+        auto left = 1_bn;
+        auto right = 10000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000_bn;
+        const auto copy = right;
+        swap(left, right);
+        REQUIRE(left == copy);
+        REQUIRE(right == 1_bn);
+    }
+
+    SECTION( "Machine words" ) {
+        const uint64_t max = std::numeric_limits<uint64_t>::max();
+        REQUIRE(BigNum(max) == 18446744073709551615_bn);
+        REQUIRE(BigNum(uint64_t{0}) == 0_bn);
+
+        REQUIRE(999999999999999999_bn + 1 == 1000000000000000000_bn);
+        REQUIRE(1_bn + max == 18446744073709551616_bn);
+        REQUIRE(1000000000000000000000000000_bn - 1 == 999999999999999999999999999_bn);
+        REQUIRE(18446744073709551616_bn - max == 1_bn);
+
+        REQUIRE(123456789123456789123_bn % 10 == 3);
+        REQUIRE(100000000000000000000000000000_bn % (max - 58) == 7886392376353987866ull);
+        REQUIRE_THROWS_AS(1_bn % 0, std::invalid_argument);
+
+        REQUIRE(18446744073709551615_bn == max);
+        REQUIRE(18446744073709551616_bn != max);
+        REQUIRE(0_bn == 0);
+    }
+
+    SECTION( "Bits" ) {
+        const auto num = 340282366920938463463374607431768211457_bn; /// 2^128 + 1
+        REQUIRE((1_bn << 128) + 1 == num);
+        REQUIRE((num >> 128) == 1_bn);
+        REQUIRE((num >> 1) == 170141183460469231731687303715884105728_bn);
+        REQUIRE((num >> 200) == 0_bn);
+        REQUIRE((0_bn << 77) == 0_bn);
+        REQUIRE((123456789123456789_bn << 0) == 123456789123456789_bn);
+        REQUIRE(((123456789123456789123456789_bn << 61) >> 61) == 123456789123456789123456789_bn);
+
+        auto shifted = 999999999999999999_bn;
+        shifted <<= 3;
+        REQUIRE(shifted == 7999999999999999992_bn);
+        shifted >>= 4;
+        REQUIRE(shifted == 499999999999999999_bn);
+
+        REQUIRE(isOdd(num));
+        REQUIRE(isEven(num - 1));
+        REQUIRE(isEven(0_bn));
+        REQUIRE(lowBits(1000000005_bn, 3) == 5);
+        REQUIRE(lowBits(num - 2, 64) == std::numeric_limits<uint64_t>::max());
+        REQUIRE(lowBits(123456789123456789123_bn, 40) == 123456789123456789123_bn % (uint64_t{1} << 40));
+        REQUIRE_THROWS_AS(lowBits(num, 65), std::invalid_argument);
+
+        REQUIRE(bitLength(0_bn) == 0);
+        REQUIRE(bitLength(1_bn) == 1);
+        REQUIRE(bitLength(num) == 129);
+        REQUIRE(bitLength(num - 2) == 128);
+        REQUIRE(testBit(num, 0));
+        REQUIRE(testBit(num, 128));
+        REQUIRE_FALSE(testBit(num, 64));
+        REQUIRE(testBit(num - 2, 100));
+        REQUIRE(popcount(num) == 2);
+        REQUIRE(popcount(num - 2) == 128);
+        REQUIRE(popcount(0_bn) == 0);
+        REQUIRE((num & (num - 2)) == 1_bn);
+        REQUIRE((255_bn & 1000_bn) == 232_bn);
+    }
+
+    SECTION( "Output parameters" ) {
+        const auto a = 123456789123456789123456789_bn;
+        const auto b = 987654321987654321_bn;
+        const auto long_num = BigNum(std::string(400, '7'));
+        BigNum out;
+
+        addInto(out, a, b);
+        REQUIRE(out == a + b);
+        subtractInto(out, a, b);
+        REQUIRE(out == a - b);
+        multiplyInto(out, a, b);
+        REQUIRE(out == a * b);
+        multiplyInto(out, long_num, long_num);
+        REQUIRE(out == long_num * long_num);
+        multiplyInto(out, a, 0_bn);
+        REQUIRE(out == 0_bn);
+
+        out = b;
+        addInto(out, a, out);
+        REQUIRE(out == a + b);
+        subtractInto(out, out, b);
+        REQUIRE(out == a);
+        subtractInto(out, a + a, out);
+        REQUIRE(out == a);
+        multiplyInto(out, out, out);
+        REQUIRE(out == a * a);
+    }
+
     SECTION( "Multiplication" ) {
         SECTION("Common") {
             const auto a = 999999999_bn;
@@ -262,6 +539,24 @@ TEST_CASE("Big numbers test", "[BigNum]") {
             const auto b = 9999101010101000010130929493583285892397887897238874399999_bn;
             REQUIRE(a * b == 999901336365994481304641755778280969957261726037535427297722733918150118427240475620078108944452582380001_bn);
         }
+
+        SECTION ( "Long" ) {
+            const auto a = 999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999_bn;
+            REQUIRE(a * a + a + a + 1_bn == (a + 1_bn) * (a + 1_bn));
+            REQUIRE(a * 0_bn == 0_bn);
+        }
+
+        SECTION ( "Karatsuba" ) {
+            std::string digits;
+            for (int i = 0; i < 700; ++i) {
+                digits += static_cast<char>('1' + i % 9);
+            }
+            const BigNum a(digits);
+            const BigNum b(digits.substr(0, 450));
+            const auto product = a * b;
+            REQUIRE(product / b == a);
+            REQUIRE(product % a == 0_bn);
+        }
     }
 
     SECTION( "Modulo multiplication" ) {
@@ -283,6 +578,29 @@ TEST_CASE("Big numbers test", "[BigNum]") {
         REQUIRE(sqrt(10007_bn, 20011_bn) == std::pair(5382_bn, 14629_bn));
     }
 
+    SECTION( "Jacobi symbol" ) {
+        REQUIRE(jacobi(1001_bn, 9907_bn) == -1);
+        REQUIRE(jacobi(19_bn, 45_bn) == 1);
+        REQUIRE(jacobi(8_bn, 21_bn) == -1);
+        REQUIRE(jacobi(21_bn, 15_bn) == 0);
+        REQUIRE(jacobi(0_bn, 1_bn) == 1);
+        REQUIRE(jacobi(1606938044258990275541962092341162602522202993782792835301381_bn,
+                       5391030899743293631239539488528815119194426882613553319203_bn) == 0);
+        REQUIRE_THROWS_AS(jacobi(3_bn, 20_bn), std::invalid_argument);
+
+        const auto p = 115792089237316195423570985008687907853269984665640564039457584007908834671663_bn;
+        REQUIRE(jacobi(7_bn, p) == -1);
+        REQUIRE(jacobi(515377520732011331036461129765621272702107522003_bn, p) == 1);
+        REQUIRE(jacobi(1606938044258990275541962092341162602522202993782792835301379_bn, p) == -1);
+        REQUIRE(jacobi(p - 1, p) == -1);
+
+        /// Euler's criterion for prime modulo
+        const auto q = 20011_bn;
+        for (auto a = 1_bn; a < 200_bn; a += 1) {
+            REQUIRE(jacobi(a, q) == (powMontgomery(a, (q - 1) >> 1, q) == 1 ? 1 : -1));
+        }
+    }
+
     SECTION("Calculate Montgomery coefficient") {
         {
             const auto mod = 23321723123_bn;
@@ -495,6 +813,15 @@ TEST_CASE("Big numbers test", "[BigNum]") {
                                                              {275213684783_bn, 1_bn}};
             REQUIRE(factorization(num) == result);
         }
+
+        SECTION("Factors above trial division bound"){
+            /// Repeated and distinct 32-bit primes are split by Pollard's rho
+            const auto num = 4294967291_bn * 4294967291_bn * 4294967279_bn * 65537_bn;
+            std::vector<std::pair<BigNum, BigNum>> result = {{65537_bn, 1_bn},
+                                                             {4294967279_bn, 1_bn},
+                                                             {4294967291_bn, 2_bn}};
+            REQUIRE(factorization(num) == result);
+        }
     }
 
     SECTION("sqrt of BigNum") {
@@ -577,6 +904,36 @@ TEST_CASE("Big numbers test", "[BigNum]") {
         }
     }
 
+    SECTION("Roots with remainder") {
+        const auto num = 703758438932656861898686708489325496297603035101995771410283891551704235535846805641186489059028785250600705578662421603847588743084826373582406172389877_bn;
+        const auto root_of_num = 26528445844652431540200652577186023347159595511198273709602794928121559272570_bn;
+        REQUIRE(sqrtRem(num) == std::pair(root_of_num, 840459398523853619199876252801696943765092266921208896918666914658617984977_bn));
+        REQUIRE(sqrtRem(root_of_num * root_of_num) == std::pair(root_of_num, 0_bn));
+        REQUIRE(sqrtRem(0_bn) == std::pair(0_bn, 0_bn));
+        REQUIRE(sqrtRem(999999999999999999_bn) == std::pair(999999999_bn, 1999999998_bn));
+        REQUIRE(sqrtRem(1000000000000000000_bn) == std::pair(1000000000_bn, 0_bn));
+
+        for (auto x = 0_bn; x < 300_bn; x += 1) {
+            REQUIRE(isPerfectSquare(x * x));
+            REQUIRE_FALSE(isPerfectSquare(x * x + x + x + 2));
+        }
+        REQUIRE(isPerfectSquare(root_of_num * root_of_num));
+        REQUIRE_FALSE(isPerfectSquare(root_of_num * root_of_num + 1));
+        REQUIRE_FALSE(isPerfectSquare(num));
+
+        REQUIRE(root(num, 1) == num);
+        REQUIRE(root(num, 2) == root_of_num);
+        REQUIRE(root(num, 3) == 889490277049363756889796278401804962053412303918698_bn);
+        REQUIRE(root(num, 5) == 3710946755227295594984053010830_bn);
+        REQUIRE(root(num, 17) == 979546187_bn);
+        REQUIRE(root(num, 100) == 33_bn);
+        REQUIRE(root(num, 1000) == 1_bn);
+        REQUIRE(root(0_bn, 3) == 0_bn);
+        REQUIRE(root(1000000000000_bn, 3) == 10000_bn);
+        REQUIRE(root(999999999999_bn, 3) == 9999_bn);
+        REQUIRE_THROWS_AS(root(num, 0), std::invalid_argument);
+    }
+
     SECTION("log of BigNum") {
         SECTION("easy") {
             {
@@ -2,6 +2,8 @@
 #include <PredefineEllipticCurves.hpp>
 
 #include <sstream>
+#include <string>
+#include <unordered_set>
 
 #include "catch.hpp"
 
@@ -125,6 +127,37 @@ TEST_CASE("Elliptic curves test", "[curves]") {
             REQUIRE(curveDataBase[0].curves[0].powerPoint(p, 58418_bn) == EllipticCurve::neutral);
 
         }
+
+        SECTION("Baby-step giant-step on 40-bit modulo") {
+            const auto modulo = 1099511627791_bn;
+            Field field(modulo);
+            const EllipticCurve curve(&field, 1_bn, modulo - 1_bn);
+            const Point p = {1_bn, 1_bn};
+
+            const auto order = curve.pointOrder(p);
+            REQUIRE(order == 549756098984_bn);
+            REQUIRE(curve.powerPoint(p, order) == EllipticCurve::neutral);
+            for (const auto& [prime, power] : factorization(order)) {
+                REQUIRE_FALSE(curve.powerPoint(p, order / prime) == EllipticCurve::neutral);
+            }
+        }
+
+        SECTION("Order below baby steps count") {
+            REQUIRE(curveDataBase[0].curves[2].pointOrder({234117_bn, 0_bn}) == 2_bn);
+            REQUIRE(curveDataBase[0].curves[2].pointOrder(EllipticCurve::neutral) == 1_bn);
+        }
+
+        SECTION("Modulo too large for baby steps") {
+            const auto modulo = 115792089237316195423570985008687907853269984665640564039457584007908834671663_bn;
+            Field field(modulo);
+            const EllipticCurve curve(&field, 1_bn, modulo - 1_bn);
+            REQUIRE_THROWS_AS(curve.pointOrder({1_bn, 1_bn}), std::invalid_argument);
+
+            /// 2^80 + 13 has 81 bits
+            Field above_limit(1208925819614629174706189_bn);
+            const EllipticCurve above_limit_curve(&above_limit, 1_bn, 1208925819614629174706188_bn);
+            REQUIRE_THROWS_AS(above_limit_curve.pointOrder({1_bn, 1_bn}), std::invalid_argument);
+        }
     }
     SECTION("Curve conatains result"){
         SECTION("Adding points"){
@@ -137,6 +170,163 @@ TEST_CASE("Elliptic curves test", "[curves]") {
         SECTION("Check first curve"){
             REQUIRE(curveDataBase[2].curves[2].countPoints() == 750_bn);
         }
+        SECTION("Even field modulo"){
+            /// Jacobi symbol isn't taken for even modulo, so it fails on order search as any composite one
+            Field field(1000_bn);
+            const EllipticCurve curve(&field, 1_bn, 1_bn);
+            REQUIRE_THROWS_WITH(curve.countPoints(), "Point order wasn't found in Hasse interval, field modulo must be prime");
+        }
     }
 
+
+    SECTION("Point hashing") {
+        const Point p(17_bn, 42_bn);
+        REQUIRE(hash(p) == hash(Point(17_bn, 42_bn)));
+        REQUIRE(hash(p) != hash(Point(42_bn, 17_bn)));
+        REQUIRE(std::hash<Point>{}(p) == hash(p));
+
+        std::unordered_set<Point> points = {p, Point(42_bn, 17_bn), EllipticCurve::neutral, p};
+        REQUIRE(points.size() == 3);
+        REQUIRE(points.count(Point(17_bn, 42_bn)) == 1);
+    }
+
+    SECTION("Point encoding") {
+        const auto toBytesOf = [](const std::string& hex) {
+            std::vector<std::byte> result;
+            for (std::size_t i = 0; i < hex.size(); i += 2) {
+                result.push_back(static_cast<std::byte>(std::stoi(hex.substr(i, 2), nullptr, 16)));
+            }
+            return result;
+        };
+
+        SECTION("secp256k1 generator") {
+            Field field(115792089237316195423570985008687907853269984665640564039457584007908834671663_bn);
+            const EllipticCurve curve(&field, 0_bn, 7_bn);
+            const Point g = {55066263022277343669578718895168534326250603453777594175500187360389116729240_bn,
+                             32670510020758816978083085130507043184471273380659243275938904335757337482424_bn};
+            const auto compressed = toBytesOf("0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798");
+
+            REQUIRE(curve.encodedSize(PointFormat::Compressed) == 33);
+            REQUIRE(curve.encodedSize(PointFormat::Uncompressed) == 65);
+            REQUIRE(curve.encodePoint(g, PointFormat::Compressed) == compressed);
+            REQUIRE(curve.decodePoint(compressed.data(), compressed.size()) == g);
+
+            const auto uncompressed = curve.encodePoint(g, PointFormat::Uncompressed);
+            REQUIRE(uncompressed[0] == std::byte{0x04});
+            REQUIRE(curve.decodePoint(uncompressed.data(), uncompressed.size()) == g);
+
+            const auto inverted = curve.encodePoint(curve.invertedPoint(g), PointFormat::Compressed);
+            REQUIRE(inverted[0] == std::byte{0x03});
+            REQUIRE(curve.decodePoint(inverted.data(), inverted.size()) == curve.invertedPoint(g));
+        }
+
+        SECTION("Round trip for every kind of modulo") {
+            /// y^2 = x^3 + x - 1 contains (1, 1), moduli are 1, 5, 7 and 3 modulo 8
+            for (const auto& modulo : {26959946667150639794667015087019630673557916260026308143510066298881_bn,
+                                       57896044618658097711785492504343953926634992332820282019728792003956564819949_bn,
+                                       115792089237316195423570985008687907853269984665640564039457584007908834671663_bn,
+                                       234131_bn}) {
+                Field field(modulo);
+                const EllipticCurve curve(&field, 1_bn, modulo - 1_bn);
+                std::vector<Point> points = {{1_bn, 1_bn}};
+                for (uint64_t i = 2; i < 10; ++i) {
+                    points.push_back(curve.addPoints(points.back(), points[0]));
+                }
+
+                for (const auto format : {PointFormat::Compressed, PointFormat::Uncompressed}) {
+                    std::vector<std::byte> batch;
+                    for (const auto& p : points) {
+                        const auto encoded = curve.encodePoint(p, format);
+                        REQUIRE(encoded.size() == curve.encodedSize(format));
+                        REQUIRE(curve.decodePoint(encoded.data(), encoded.size()) == p);
+                        batch.insert(batch.end(), encoded.begin(), encoded.end());
+                    }
+                    REQUIRE(curve.decodePoints(batch.data(), points.size(), format) == points);
+                }
+            }
+        }
+
+        SECTION("Neutral and malformed encodings") {
+            Field field(234131_bn);
+            const EllipticCurve curve(&field, 1_bn, 234130_bn);
+            const auto neutral = curve.encodePoint(EllipticCurve::neutral, PointFormat::Compressed);
+            REQUIRE(neutral == std::vector<std::byte>{std::byte{0x00}});
+            REQUIRE(curve.decodePoint(neutral.data(), neutral.size()) == EllipticCurve::neutral);
+
+            auto encoded = curve.encodePoint({1_bn, 1_bn}, PointFormat::Compressed);
+            REQUIRE_THROWS_AS(curve.decodePoint(encoded.data(), encoded.size() - 1), std::invalid_argument);
+            REQUIRE_THROWS_AS(curve.decodePoints(encoded.data(), 1, PointFormat::Uncompressed), std::invalid_argument);
+            encoded[0] = std::byte{0x05};
+            REQUIRE_THROWS_AS(curve.decodePoint(encoded.data(), encoded.size()), std::invalid_argument);
+
+            /// x = 234131 is not reduced
+            const auto too_big = toBytesOf("03039293");
+            REQUIRE_THROWS_AS(curve.decodePoint(too_big.data(), too_big.size()), std::invalid_argument);
+
+            /// x^3 + x - 1 is not a square for x = 3
+            const auto no_root = toBytesOf("02000003");
+            REQUIRE_THROWS_AS(curve.decodePoint(no_root.data(), no_root.size()), std::invalid_argument);
+
+            auto off_curve = curve.encodePoint({1_bn, 1_bn}, PointFormat::Uncompressed);
+            off_curve.back() = std::byte{0x02};
+            REQUIRE_THROWS_AS(curve.decodePoint(off_curve.data(), off_curve.size()), std::invalid_argument);
+        }
+    }
+
+    SECTION("Backend dispatch") {
+        SECTION("Picked by size of modulo") {
+            REQUIRE(curveDataBase[0].curves[0].backend() == CurveBackend::MachineWord);
+            REQUIRE(curveDataBase[2].curves[1].backend() == CurveBackend::MachineWord);
+
+            Field even(1000_bn);
+            REQUIRE(EllipticCurve(&even, 1_bn, 1_bn).backend() == CurveBackend::Generic);
+        }
+
+        SECTION("Same group law on every backend") {
+            /// y^2 = x^3 + x - 1 contains (1, 1) and 2 * (1, 1) = (2, -3) for every prime modulo
+            const std::vector<std::pair<BigNum, CurveBackend>> moduli = {
+                {234131_bn, CurveBackend::MachineWord},
+                {115792089237316195423570985008687907853269984665640564039457584007908834671663_bn, CurveBackend::Fixed256},
+                {39402006196394479212279040100143613805079739270465446667948293404245721771496870329047266088258938001861606973112319_bn, CurveBackend::Fixed384},
+                {6864797660130609714981900799081393217269435300143305409394463459185543183397656052122559640661454554977296311391480858037121987999716643812574028291115057151_bn, CurveBackend::Fixed521},
+                {531137992816767098689588206552468627329593117727031923199444138200403559860852242739162502265229285668889329486246501015346579337652707239409519978766587351943831270835393219031728127_bn, CurveBackend::Generic}
+            };
+
+            for (const auto& [modulo, backend] : moduli) {
+                Field field(modulo);
+                const EllipticCurve curve(&field, 1_bn, modulo - 1_bn);
+                REQUIRE(curve.backend() == backend);
+
+                const Point p = {1_bn, 1_bn};
+                const Point doubled = {2_bn, modulo - 3_bn};
+                REQUIRE(curve.contains(p));
+                REQUIRE(curve.addPoints(p, p) == doubled);
+                REQUIRE(curve.powerPoint(p, 2_bn) == doubled);
+                REQUIRE(curve.addPoints(doubled, curve.invertedPoint(p)) == p);
+                REQUIRE(curve.addPoints(p, curve.invertedPoint(p)) == EllipticCurve::neutral);
+            }
+        }
+
+        SECTION("Batch addition") {
+            /// Generic points, the addend itself, its inverse and neutral point in one batch
+            const auto modulo = 234131_bn;
+            const BasicEllipticCurve<BigNumField> curve(BigNumField(Modulus(modulo)), 1_bn, modulo - 1_bn);
+            const auto p = curve.makePoint(1_bn, 1_bn);
+            std::vector<BasicPoint<BigNum>> points = {p, curve.neutral()};
+            for (int i = 0; i < 6; i++) {
+                points.push_back(curve.addPoints(points.back().is_neutral ? p : points.back(), p));
+            }
+            const auto addend = points[3];
+            points.push_back(addend);
+            points.push_back(curve.invertedPoint(addend));
+
+            const auto sums = curve.addPointsBatch(points.data(), points.size(), addend);
+            REQUIRE(sums.size() == points.size());
+            for (std::size_t i = 0; i < points.size(); i++) {
+                REQUIRE(sums[i] == curve.addPoints(points[i], addend));
+            }
+            REQUIRE(sums.back().is_neutral);
+            REQUIRE(curve.addPointsBatch(points.data(), points.size(), curve.neutral()) == points);
+        }
+    }
 }
@@ -0,0 +1,129 @@
+#include <FixedBigNum.hpp>
+#include <CurveEngine.hpp>
+#include <EllipticCurves.hpp>
+#include <PredefineEllipticCurves.hpp>
+
+#include "catch.hpp"
+
+namespace {
+    using Num128 = lab::FixedBigNum<128>;
+
+    constexpr Num128 MAX_LOW = Num128(~uint64_t{0});
+    static_assert((MAX_LOW + Num128(1))[1] == 1, "Carry must reach the next word");
+    static_assert((Num128(0) - Num128(1)) == Num128({~uint64_t{0}, ~uint64_t{0}}), "Subtraction must wrap");
+    static_assert((MAX_LOW * MAX_LOW) == Num128({1, ~uint64_t{0} - 1}), "Product must be exact");
+    static_assert((Num128(1) << 100).testBit(100) && (Num128(1) << 100).bitLength() == 101, "Shift must move bits");
+    static_assert(((Num128(5) << 70) >> 70) == Num128(5), "Shifts must be inverse");
+    static_assert(Num128(3) < Num128(1) << 64, "Comparison must look at the highest word first");
+
+    using lab::operator""_fbn;
+    static_assert(18446744073709551616_fbn == lab::FixedBigNum<65>({0, 1}), "Literal must carry into the next word");
+    static_assert(decltype(234131_fbn)::LIMBS == 1 && (0_fbn).isZero(), "Literal must be as wide as its value");
+    static_assert(Num128(1'000'000'007_fbn) == Num128(1000000007), "Literal must widen and skip separators");
+    static_assert(lab::curveConstants[1][0].modulo == lab::FixedBigNum<64>(80000005213), "Curve table must be constexpr");
+} // <anonymous> namespace
+
+TEST_CASE("Fixed width numbers test", "[FixedBigNum]") {
+    using namespace lab;
+
+    const auto secp256k1 = 115792089237316195423570985008687907853269984665640564039457584007908834671663_bn;
+
+    SECTION("Conversion to and from BigNum") {
+        const auto num = 98765432109876543210987654321098765432109876543210987654321_bn;
+        REQUIRE(static_cast<BigNum>(FixedBigNum<256>(num)) == num);
+        REQUIRE(static_cast<BigNum>(FixedBigNum<64>(0_bn)) == 0_bn);
+        REQUIRE_THROWS_AS(FixedBigNum<64>(18446744073709551616_bn), std::invalid_argument);
+        REQUIRE_THROWS_AS(FixedBigNum<100>(secp256k1), std::invalid_argument);
+    }
+
+    SECTION("Compile time literals") {
+        REQUIRE(static_cast<BigNum>(115792089237316195423570985008687907853269984665640564039457584007908834671663_fbn) == secp256k1);
+        for (int i = 0; i < FIELD_NUMBER; i++) {
+            for (const auto& constants : curveConstants[i]) {
+                REQUIRE(static_cast<BigNum>(constants.modulo) == curveDataBase[i].field.modulo);
+            }
+        }
+    }
+
+    SECTION("Wide multiplication") {
+        const auto a = 98765432109876543210987654321098765432109876543210_bn;
+        const auto b = 12345678901234567890123456789012345678901234567890_bn;
+        const auto product = FixedBigNum<256>::multiplyWide(FixedBigNum<256>(a), FixedBigNum<256>(b));
+        REQUIRE(static_cast<BigNum>(product) == a * b);
+    }
+
+    SECTION("Prime field") {
+        const FixedField<256> field(secp256k1);
+        const auto a = 65341020041517633956166170261014086368942546761318486551877808671514674964848_bn;
+        const auto b = 32670510020758816978083085130507043184471273380659243275938904335757337482424_bn;
+        const auto x = field.fromBigNum(a);
+        const auto y = field.fromBigNum(b);
+
+        REQUIRE(field.toBigNum(x) == a);
+        REQUIRE(field.toBigNum(field.mul(x, y)) == a * b % secp256k1);
+        REQUIRE(field.toBigNum(field.add(x, y)) == (a + b) % secp256k1);
+        REQUIRE(field.toBigNum(field.sub(y, x)) == secp256k1 - a + b);
+        REQUIRE(field.mul(field.inverse(x), x) == field.one());
+        REQUIRE_THROWS_AS(FixedField<64>(1000_bn), std::invalid_argument);
+    }
+
+    SECTION("Pseudo-Mersenne folding") {
+        /// Products of the largest elements carry through every fold, P-256 stays in Montgomery form
+        const auto check = [](const auto& field, const BigNum& mod) {
+            const std::vector<BigNum> nums = {1_bn, 2_bn, mod - 1_bn, mod - 2_bn, mod / 3_bn, (mod - 1_bn) / 2_bn + 12345_bn};
+            for (const auto& left : nums) {
+                for (const auto& right : nums) {
+                    REQUIRE(field.toBigNum(field.mul(field.fromBigNum(left), field.fromBigNum(right))) == left * right % mod);
+                }
+            }
+            const auto x = field.fromBigNum(mod - 5_bn);
+            REQUIRE(field.mul(field.inverse(x), x) == field.one());
+        };
+
+        check(FixedField<256>(secp256k1), secp256k1);
+        check(FixedField<256>(57896044618658097711785492504343953926634992332820282019728792003956564819949_bn),
+              57896044618658097711785492504343953926634992332820282019728792003956564819949_bn);
+        check(FixedField<256>(115792089210356248762697446949407573530086143415290314195533631308867097853951_bn),
+              115792089210356248762697446949407573530086143415290314195533631308867097853951_bn);
+        check(FixedField<521>(6864797660130609714981900799081393217269435300143305409394463459185543183397656052122559640661454554977296311391480858037121987999716643812574028291115057151_bn),
+              6864797660130609714981900799081393217269435300143305409394463459185543183397656052122559640661454554977296311391480858037121987999716643812574028291115057151_bn);
+        /// Single limb folds wrap around 2^64 more than once
+        check(FixedField<64>(2305843009213693951_bn), 2305843009213693951_bn);
+        check(FixedField<64>(18446744073709551557_bn), 18446744073709551557_bn);
+        /// 2^40 - 1048529 folds its top bits several times
+        check(FixedField<64>(1099510579247_bn), 1099510579247_bn);
+        /// 2^127 - 1 is too short for limbs of FixedField<256> and goes through Montgomery form
+        check(FixedField<256>(170141183460469231731687303715884105727_bn), 170141183460469231731687303715884105727_bn);
+    }
+
+    SECTION("Curve over fixed width field") {
+        const BasicEllipticCurve<FixedField<256>> curve(FixedField<256>(secp256k1), 0_bn, 7_bn);
+        const auto g = curve.makePoint(55066263022277343669578718895168534326250603453777594175500187360389116729240_bn,
+                                       32670510020758816978083085130507043184471273380659243275938904335757337482424_bn);
+        REQUIRE(curve.contains(g));
+
+        const auto doubled = curve.coordinates(curve.addPoints(g, g));
+        REQUIRE(doubled.first == 89565891926547004231252920425935692360644145829622209833684329913297188986597_bn);
+        REQUIRE(doubled.second == 12158399299693830322967808612713398636155367887041628176798871954788371653930_bn);
+
+        const auto order = 115792089237316195423570985008687907852837564279074904382605163141518161494337_bn;
+        REQUIRE(curve.powerPoint(g, order) == curve.neutral());
+        REQUIRE(curve.addPoints(g, curve.invertedPoint(g)) == curve.neutral());
+    }
+
+    SECTION("Same results as BigNum curve") {
+        const auto& reference = curveDataBase[1].curves[0];
+        const auto mod = reference.getFieldModulo();
+        const BasicEllipticCurve<FixedField<64>> fixed(FixedField<64>(mod), 39912548_bn, 7610314_bn);
+        const BasicEllipticCurve<BigNumField> generic(BigNumField(Modulus(mod)), 39912548_bn, 7610314_bn);
+
+        const Point p = {325_bn, 3192_bn};
+        const auto power = 98765678909876523456788_bn;
+        const Point expected = reference.powerPoint(p, power);
+
+        const auto fixed_result = fixed.coordinates(fixed.powerPoint(fixed.makePoint(p.x, p.y), power));
+        const auto generic_result = generic.coordinates(generic.powerPoint(generic.makePoint(p.x, p.y), power));
+        REQUIRE(Point(fixed_result.first, fixed_result.second) == expected);
+        REQUIRE(Point(generic_result.first, generic_result.second) == expected);
+    }
+}
@@ -0,0 +1,62 @@
+#include <ModInt.hpp>
+#include <CurveEngine.hpp>
+#include <EllipticCurves.hpp>
+#include <PredefineEllipticCurves.hpp>
+
+#include "catch.hpp"
+
+namespace {
+    using Mod773 = lab::ModInt<773>;
+
+    static_assert((Mod773(500) + Mod773(400)).value() == 127, "Sum must be reduced");
+    static_assert((Mod773(5) - Mod773(7)).value() == 771, "Difference must be reduced");
+    static_assert((Mod773(772) * Mod773(772)).value() == 1, "(-1)^2 must be 1");
+    static_assert((Mod773(2).inverse() * Mod773(2)).value() == 1, "Inverse must be exact");
+    static_assert(Mod773(3).pow(772).value() == 1, "Fermat's little theorem must hold");
+} // <anonymous> namespace
+
+TEST_CASE("Machine word modular arithmetic test", "[ModInt]") {
+    using namespace lab;
+
+    SECTION("Field fits machine word") {
+        REQUIRE(ModInt64Field::fits(773_bn));
+        REQUIRE(ModInt64Field::fits(80000005213_bn));
+        REQUIRE(ModInt64Field::fits(9223372036854775783_bn));
+        REQUIRE_FALSE(ModInt64Field::fits(9223372036854775837_bn));
+        REQUIRE_FALSE(ModInt64Field::fits(1000_bn));
+        REQUIRE_THROWS_AS(ModInt64Field(18446744073709551557_bn), std::invalid_argument);
+    }
+
+    SECTION("ModInt64Field arithmetic") {
+        const auto mod = 9223372036854775783_bn;
+        const ModInt64Field field(mod);
+        const auto a = 98765432109876543210987654321_bn;
+        const auto b = 1234567890123456789_bn;
+        const auto x = field.fromBigNum(a);
+        const auto y = field.fromBigNum(b);
+
+        REQUIRE(field.toBigNum(x) == a % mod);
+        REQUIRE(field.toBigNum(field.mul(x, y)) == a * b % mod);
+        REQUIRE(field.toBigNum(field.add(x, y)) == (a + b) % mod);
+        REQUIRE(field.toBigNum(field.sub(x, y)) == subtract(a, b, mod));
+        REQUIRE(field.mul(field.inverse(x), x) == field.one());
+        REQUIRE_THROWS_AS(field.inverse(field.zero()), std::invalid_argument);
+    }
+
+    SECTION("ModInt and BigNum") {
+        REQUIRE(ModInt<773>(597529_bn).value() == 0);
+        REQUIRE(static_cast<BigNum>(ModInt<234131>(1000000_bn)) == 1000000_bn % 234131_bn);
+    }
+
+    SECTION("Curve over compile-time field") {
+        const auto& reference = curveDataBase[2].curves[1];
+        const BasicEllipticCurve<ModIntField<773>> curve(ModIntField<773>(), 446_bn, 724_bn);
+        const Point p = {7_bn, 18_bn};
+        const auto point = curve.makePoint(p.x, p.y);
+
+        REQUIRE(curve.contains(point));
+        REQUIRE(curve.powerPoint(point, 766_bn) == curve.neutral());
+        const auto& [x, y] = curve.coordinates(curve.powerPoint(point, 123_bn));
+        REQUIRE(Point(x, y) == reference.powerPoint(p, 123_bn));
+    }
+}
@@ -0,0 +1,292 @@
+#include <Modulus.hpp>
+#include <EllipticCurves.hpp>
+
+#include "catch.hpp"
+
+TEST_CASE("Modulus test", "[Modulus]") {
+    using namespace lab;
+
+    SECTION("Barrett reduction") {
+        SECTION("small modulo") {
+            const BarrettReducer ctx(773_bn);
+            REQUIRE(ctx.reduce(772_bn) == 772_bn);
+            REQUIRE(ctx.reduce(773_bn) == 0_bn);
+            REQUIRE(ctx.reduce(597529_bn) == 597529_bn % 773_bn);
+        }
+
+        SECTION("even modulo") {
+            const BarrettReducer ctx(1000000000_bn);
+            REQUIRE(ctx.reduce(123456789987654321_bn) == 987654321_bn);
+        }
+
+        SECTION("big modulo") {
+            const auto mod = 115792089237316195423570985008687907853269984665640564039457584007908834671663_bn;
+            const auto num = 98765432109876543210987654321098765432109876543210987654321098765432109876543210987654321098765432109876543210987654321098765432109876543_bn;
+            const BarrettReducer ctx(mod);
+            REQUIRE(ctx.reduce(num) == num % mod);
+            REQUIRE(ctx.reduce(mod * mod - 1_bn) == mod - 1_bn);
+        }
+
+        SECTION("longer than 2k cells") {
+            const BarrettReducer ctx(1000000007_bn);
+            const auto num = 123456789123456789123456789123456789123456789_bn;
+            REQUIRE(ctx.reduce(num) == num % 1000000007_bn);
+        }
+    }
+
+    SECTION("Modulo arithmetic with reducer") {
+        const auto mod = 666666666666_bn;
+        const BarrettReducer ctx(mod);
+        const BigNum a("12345678907777456243534");
+        const BigNum b("1234560007774123570039999");
+
+        REQUIRE(add(a, b, ctx) == add(a, b, mod));
+        REQUIRE(subtract(a, b, ctx) == subtract(a, b, mod));
+        REQUIRE(multiply(a, b, ctx) == multiply(a, b, mod));
+    }
+
+    SECTION("Pow and inversion with reducer") {
+        const BarrettReducer ctx(624334409_bn);
+        REQUIRE(pow(12345123455485945_bn, 12312312341234_bn, ctx) == 404851936_bn);
+        REQUIRE(inverted(1442141324241124_bn, BarrettReducer(191_bn), BigNum::InversionPolicy::Fermat) == 12_bn);
+        REQUIRE(inverted(1442141324241124_bn, BarrettReducer(23321723123_bn), BigNum::InversionPolicy::Euclid) == 515791030_bn);
+    }
+
+    SECTION("Output parameters") {
+        const auto p256 = 115792089210356248762697446949407573530086143415290314195533631308867097853951_bn;
+        const BarrettReducer barrett(p256);
+        const Modulus modulus(p256);
+        const auto a = 98765432109876543210987654321098765432109876543210_bn;
+        const auto b = 115792089210356248762697446949407573530086143415290314195533631308867097853900_bn;
+        BigNum out;
+
+        mulMod(out, a, b, barrett);
+        REQUIRE(out == multiply(a, b, p256));
+        sqrMod(out, b, modulus);
+        REQUIRE(out == multiply(b, b, p256));
+        addMod(out, a, b, barrett);
+        REQUIRE(out == add(a, b, p256));
+        subMod(out, a, b, modulus);
+        REQUIRE(out == subtract(a, b, p256));
+        subMod(out, b, a, barrett);
+        REQUIRE(out == subtract(b, a, p256));
+        subMod(out, p256 + a, b, barrett);
+        REQUIRE(out == subtract(a, b, p256));
+
+        out = a;
+        mulMod(out, out, out, modulus);
+        REQUIRE(out == multiply(a, a, p256));
+        addMod(out, out, b, barrett);
+        REQUIRE(out == add(multiply(a, a, p256), b, p256));
+        subMod(out, a, out, barrett);
+        REQUIRE(out == subtract(a, add(multiply(a, a, p256), b, p256), p256));
+    }
+
+    SECTION("Square root with context") {
+        /// Moduli 1, 5, 7 and 3 modulo 8 and the smallest quadratic non-residue of each
+        const std::vector<std::pair<BigNum, BigNum>> moduli = {
+            {26959946667150639794667015087019630673557916260026308143510066298881_bn, 11_bn},
+            {57896044618658097711785492504343953926634992332820282019728792003956564819949_bn, 2_bn},
+            {115792089237316195423570985008687907853269984665640564039457584007908834671663_bn, 3_bn},
+            {13_bn, 2_bn},
+            {234131_bn, 2_bn}
+        };
+        for (const auto& [p, non_residue] : moduli) {
+            const Modulus ctx(p);
+            for (const auto& x : {1_bn, 2_bn, 12_bn, 1234567_bn, p - 1}) {
+                const auto square = multiply(x, x, ctx);
+                const auto roots = sqrt(square, ctx);
+                REQUIRE(roots);
+                REQUIRE(multiply(roots->first, roots->first, ctx) == square);
+                REQUIRE(add(roots->first, roots->second, ctx) == 0_bn);
+            }
+            REQUIRE_FALSE(sqrt(non_residue, ctx));
+            REQUIRE(sqrt(p, ctx) == std::pair{0_bn, 0_bn});
+        }
+    }
+
+    SECTION("Square root methods") {
+        /// P-224 has p - 1 divisible by 2^96, so Tonelli–Shanks runs through the whole table
+        const std::vector<std::pair<BigNum, BigNum>> moduli = {
+            {26959946667150639794667015087019630673557916260026308143510066298881_bn, 11_bn},
+            {57896044618658097711785492504343953926634992332820282019728792003956564819949_bn, 2_bn},
+            {65537_bn, 3_bn},
+            {17_bn, 3_bn},
+            {7_bn, 3_bn}
+        };
+        for (const auto& [p, non_residue] : moduli) {
+            const SqrtContext context{Modulus(p)};
+            for (const auto& x : {1_bn, 3_bn, 4_bn, 123456_bn % p, p - 2}) {
+                const auto square = multiply(x, x, context.modulus());
+                const auto expected = std::min(x, p - x);
+                for (const auto method : {SqrtMethod::Auto, SqrtMethod::TonelliShanks, SqrtMethod::Cipolla}) {
+                    const auto roots = context.sqrt(square, method);
+                    REQUIRE(roots);
+                    REQUIRE(std::min(roots->first, roots->second) == expected);
+                }
+            }
+            for (const auto method : {SqrtMethod::Auto, SqrtMethod::TonelliShanks, SqrtMethod::Cipolla}) {
+                REQUIRE_FALSE(context.sqrt(non_residue, method));
+            }
+        }
+        REQUIRE(SqrtContext::cached(2_bn)->sqrt(1_bn) == std::pair{1_bn, 1_bn});
+
+        /// Contexts stay bound to their modulo when others are requested, alternating moduli share the cache
+        const auto first = SqrtContext::cached(65537_bn);
+        const auto second = SqrtContext::cached(Modulus(17_bn));
+        REQUIRE(first->modulus().modulo() == 65537_bn);
+        REQUIRE(first->sqrt(4_bn)->first * first->sqrt(4_bn)->first % 65537_bn == 4_bn);
+        REQUIRE(SqrtContext::cached(65537_bn) == first);
+        REQUIRE(SqrtContext::cached(17_bn) == second);
+        for (const auto& mod : {7_bn, 11_bn, 13_bn, 19_bn, 23_bn}) {
+            REQUIRE(SqrtContext::cached(mod)->modulus().modulo() == mod);
+        }
+        REQUIRE(SqrtContext::cached(65537_bn) != first);
+        REQUIRE(first->modulus().modulo() == 65537_bn);
+    }
+
+    SECTION("Roots of prime degree") {
+        /// Small moduli with p - 1 divisible by r^t for t up to 4, 1000000007 = 2 (mod 3) has unique cube roots
+        const std::vector<std::pair<BigNum, uint64_t>> small = {
+            {109_bn, 3}, {163_bn, 3}, {101_bn, 5}, {251_bn, 5}, {197_bn, 7}, {23_bn, 3}, {23_bn, 11}
+        };
+        for (const auto& [p, r] : small) {
+            const Modulus ctx(p);
+            std::vector<bool> is_power(std::stoul(to_string(p)), false);
+            for (auto x = 0_bn; x < p; x += 1) {
+                is_power[std::stoul(to_string(pow(x, BigNum(r), ctx)))] = true;
+            }
+            for (auto a = 0_bn; a < p; a += 1) {
+                const auto root = rootMod(a, r, ctx);
+                REQUIRE(root.has_value() == is_power[std::stoul(to_string(a))]);
+                if (root) {
+                    REQUIRE(pow(*root, BigNum(r), ctx) == a);
+                }
+            }
+        }
+
+        const std::vector<std::pair<BigNum, uint64_t>> large = {
+            {115792089237316195423570985008687907853269984665640564039457584007908834671663_bn, 3},
+            {115792089237316195423570985008687907853269984665640564039457584007908834671663_bn, 7},
+            {115792089210356248762697446949407573530086143415290314195533631308867097853951_bn, 5},
+            {57896044618658097711785492504343953926634992332820282019728792003956564819949_bn, 3},
+            {1000000007_bn, 3}
+        };
+        for (const auto& [p, r] : large) {
+            const Modulus ctx(p);
+            for (const auto& x : {2_bn, 12345_bn, 55066263022277343669578718895168534326250603453777594175500187360389116729240_bn % p}) {
+                const auto a = pow(x, BigNum(r), ctx);
+                const auto root = rootMod(a, r, p);
+                REQUIRE(root);
+                REQUIRE(pow(*root, BigNum(r), ctx) == a);
+            }
+        }
+        REQUIRE_FALSE(rootMod(2_bn, 3, 115792089237316195423570985008687907853269984665640564039457584007908834671663_bn));
+        REQUIRE(rootMod(8_bn, 3, 1000000007_bn) == 2_bn);
+        REQUIRE_THROWS_AS(rootMod(8_bn, 0, 1000000007_bn), std::invalid_argument);
+        /// 2 is a root of both, but composite degrees are rejected
+        REQUIRE_THROWS_AS(rootMod(64_bn, 6, 1000000007_bn), std::invalid_argument);
+        REQUIRE_THROWS_AS(rootMod(16_bn, 4, 1000000007_bn), std::invalid_argument);
+
+        /// beta of GLV endomorphism on secp256k1
+        const Modulus secp256k1(115792089237316195423570985008687907853269984665640564039457584007908834671663_bn);
+        const auto beta = rootOfUnity(3, secp256k1);
+        REQUIRE(beta);
+        REQUIRE(*beta != 1_bn);
+        REQUIRE(pow(*beta, 3_bn, secp256k1) == 1_bn);
+        REQUIRE_FALSE(rootOfUnity(3, Modulus(1000000007_bn)));
+        REQUIRE(rootOfUnity(2, Modulus(1000000007_bn)) == 1000000006_bn);
+    }
+
+    SECTION("Binary words") {
+        const auto num = 703758438932656861898686708489325496297603035101995771410283891551704235535846805641186489059028785250600705578662421603847588743084826373582406172389877_bn;
+        REQUIRE(fromWords(toWords(num)) == num);
+        REQUIRE(toWords(0_bn) == std::vector<uint64_t>{0});
+        REQUIRE(toWords(18446744073709551616_bn) == std::vector<uint64_t>{0, 1});
+        REQUIRE(fromWords({0, 1}) == 18446744073709551616_bn);
+    }
+
+    SECTION("Modulus form detection") {
+        const auto curve25519 = 57896044618658097711785492504343953926634992332820282019728792003956564819949_bn;
+        const auto secp256k1 = 115792089237316195423570985008687907853269984665640564039457584007908834671663_bn;
+        const auto p256 = 115792089210356248762697446949407573530086143415290314195533631308867097853951_bn;
+        const auto p192 = 6277101735386680763835789423207666416083908700390324961279_bn;
+        const auto p521 = 6864797660130609714981900799081393217269435300143305409394463459185543183397656052122559640661454554977296311391480858037121987999716643812574028291115057151_bn;
+
+        REQUIRE(Modulus(curve25519).form() == ModulusForm::PseudoMersenne);
+        REQUIRE(Modulus(secp256k1).form() == ModulusForm::PseudoMersenne);
+        REQUIRE(Modulus(p521).form() == ModulusForm::PseudoMersenne);
+        REQUIRE(Modulus(p256).form() == ModulusForm::Solinas);
+        REQUIRE(Modulus(p192).form() == ModulusForm::Solinas);
+        REQUIRE(Modulus(773_bn).form() == ModulusForm::Generic);
+        REQUIRE(Modulus(80000005213_bn).form() == ModulusForm::Generic);
+
+        SECTION("declared form") {
+            REQUIRE(Modulus(curve25519, ModulusForm::Solinas).form() == ModulusForm::Solinas);
+            REQUIRE(Modulus(p256, ModulusForm::Generic).form() == ModulusForm::Generic);
+            REQUIRE_THROWS_AS(Modulus(p256, ModulusForm::PseudoMersenne), std::invalid_argument);
+            REQUIRE_THROWS_AS(Modulus(773_bn, ModulusForm::Solinas), std::invalid_argument);
+        }
+    }
+
+    SECTION("Special form reduction") {
+        const auto num = 703758438932656861898686708489325496297603035101995771410283891551704235535846805641186489059028785250600705578662421603847588743084826373582406172389877_bn;
+        const Modulus curve25519(57896044618658097711785492504343953926634992332820282019728792003956564819949_bn);
+        const Modulus p256(115792089210356248762697446949407573530086143415290314195533631308867097853951_bn);
+
+        const auto reduced = [](const Modulus& mod, const BigNum& value) {
+            auto words = toWords(value);
+            mod.reduce(words);
+            return fromWords(words);
+        };
+
+        REQUIRE(reduced(curve25519, num) == 13025381432008497440073706148643234369954105513352898573811697528511791981187_bn);
+        REQUIRE(reduced(p256, num) == 94703500887876562879679022222005242658944512080398036914242738987836794264970_bn);
+        REQUIRE(reduced(p256, p256.modulo()) == 0_bn);
+        REQUIRE(reduced(curve25519, curve25519.modulo() + 5_bn) == 5_bn);
+        REQUIRE(reduced(Modulus(773_bn), 597529_bn) == 597529_bn % 773_bn);
+        REQUIRE(curve25519.reduce(num) == 13025381432008497440073706148643234369954105513352898573811697528511791981187_bn);
+    }
+
+    SECTION("Special form pow") {
+        const auto p256 = 115792089210356248762697446949407573530086143415290314195533631308867097853951_bn;
+        const auto base = 98765432109876543210987654321098765432109876543210_bn;
+        const auto degree = 123456789012345678901234567890_bn;
+        REQUIRE(pow(base, degree, Modulus(p256)) == pow(base, degree, BarrettReducer(p256)));
+        REQUIRE(multiply(inverted(base, Modulus(p256), BigNum::InversionPolicy::Fermat), base, Modulus(p256)) == 1_bn);
+    }
+
+    SECTION("Exponent recoding") {
+        const auto secp256k1 = 115792089237316195423570985008687907853269984665640564039457584007908834671663_bn;
+        const auto p256 = 115792089210356248762697446949407573530086143415290314195533631308867097853951_bn;
+        const auto base = 98765432109876543210987654321098765432109876543210_bn;
+        for (const auto& ctx : {Modulus(secp256k1), Modulus(p256), Modulus(secp256k1, ModulusForm::Generic), Modulus(1000000007_bn)}) {
+            for (const auto& degree : {0_bn, 1_bn, 2_bn, 3_bn, 16_bn, 18446744073709551616_bn,
+                                       123456789012345678901234567890_bn, ctx.modulo() - 2}) {
+                REQUIRE(ctx.pow(base, ExponentRecoding(degree)) == pow(base, degree, BarrettReducer(ctx.modulo())));
+            }
+            REQUIRE(multiply(inverted(base, ctx, BigNum::InversionPolicy::Fermat), base, ctx) == 1_bn);
+        }
+
+        /// p - 2 of secp256k1 has 249 nonzero bits out of 256, binary method takes 503 multiplications
+        const Modulus secp256k1_ctx(secp256k1);
+        const auto& recoding = secp256k1_ctx.inversionExponent();
+        REQUIRE(recoding.width() == 5);
+        REQUIRE(recoding.multiplications() < 320);
+        REQUIRE(ExponentRecoding(0_bn).multiplications() == 0);
+        REQUIRE(ExponentRecoding(1_bn).multiplications() == 0);
+        REQUIRE(ExponentRecoding(8_bn).multiplications() == 3);
+    }
+
+    SECTION("Point doubling on secp256k1") {
+        Field field(115792089237316195423570985008687907853269984665640564039457584007908834671663_bn);
+        const EllipticCurve curve(&field, 0_bn, 7_bn);
+        const Point g = {55066263022277343669578718895168534326250603453777594175500187360389116729240_bn,
+                         32670510020758816978083085130507043184471273380659243275938904335757337482424_bn};
+        const Point expected = {89565891926547004231252920425935692360644145829622209833684329913297188986597_bn,
+                                12158399299693830322967808612713398636155367887041628176798871954788371653930_bn};
+        REQUIRE(field.reducer.form() == ModulusForm::PseudoMersenne);
+        REQUIRE(curve.contains(g));
+        REQUIRE(curve.addPoints(g, g) == expected);
+    }
+}
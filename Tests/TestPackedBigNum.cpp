@@ -0,0 +1,39 @@
+#include <PackedBigNum.hpp>
+
+#include "catch.hpp"
+
+#include <string>
+#include <unordered_map>
+
+TEST_CASE("Packed big numbers test", "[PackedBigNum]") {
+    using namespace lab;
+
+    const auto p256 = 115792089210356248762697446949407573530086143415290314195533631308867097853951_bn;
+
+    SECTION("Round trip") {
+        REQUIRE(PackedBigNum(p256).unpack() == p256);
+        REQUIRE(static_cast<BigNum>(PackedBigNum(0_bn)) == 0_bn);
+        REQUIRE(PackedBigNum(999999999_bn).unpack() == 999999999_bn);
+
+        const BigNum long_num(std::string(300, '9'));
+        REQUIRE(PackedBigNum(long_num).unpack() == long_num);
+    }
+
+    SECTION("Smaller than BigNum") {
+        REQUIRE(sizeof(PackedBigNum) * 2 < sizeof(BigNum));
+    }
+
+    SECTION("Equality and hashing") {
+        REQUIRE(PackedBigNum(p256) == PackedBigNum(p256));
+        REQUIRE(PackedBigNum(p256) != PackedBigNum(p256 - 1));
+        REQUIRE(hash(PackedBigNum(p256)) == hash(p256));
+        REQUIRE(std::hash<PackedBigNum>{}(PackedBigNum(1000000001_bn)) == std::hash<BigNum>{}(1000000001_bn));
+
+        std::unordered_map<PackedBigNum, PackedBigNum> table;
+        for (uint64_t i = 0; i < 100; ++i) {
+            table[PackedBigNum(p256 - i)] = PackedBigNum(BigNum(i));
+        }
+        REQUIRE(table.size() == 100);
+        REQUIRE(table.at(PackedBigNum(p256 - 42)).unpack() == 42_bn);
+    }
+}
@@ -0,0 +1,62 @@
+#include <SmallVector.hpp>
+#include <BigNum.hpp>
+
+#include <cstdint>
+#include <utility>
+
+#include "catch.hpp"
+
+TEST_CASE("Small vector test", "[SmallVector]") {
+    using namespace lab;
+    using Cells = SmallVector<int64_t, 4>;
+
+    SECTION("Stays inline up to capacity") {
+        Cells cells;
+        for (int64_t i = 0; i < 4; ++i) {
+            cells.push_back(i);
+        }
+        REQUIRE(cells.isInline());
+        REQUIRE(cells.size() == 4);
+        REQUIRE(cells.back() == 3);
+    }
+
+    SECTION("Spills to heap and keeps elements") {
+        Cells cells(3, 7);
+        cells.push_back(cells[0]);
+        cells.push_back(cells[0]);
+        REQUIRE_FALSE(cells.isInline());
+        REQUIRE(cells == Cells({7, 7, 7, 7, 7}));
+
+        cells.resize(2);
+        REQUIRE(cells == Cells({7, 7}));
+    }
+
+    SECTION("Copy and move") {
+        const Cells small = {1, 2};
+        const Cells big = {1, 2, 3, 4, 5, 6};
+
+        Cells copy = big;
+        REQUIRE(copy == big);
+        copy = small;
+        REQUIRE(copy == small);
+
+        Cells moved_small = Cells(small);
+        Cells moved_big = Cells(big);
+        REQUIRE(moved_small == small);
+        REQUIRE(moved_big == big);
+
+        moved_small = std::move(moved_big);
+        REQUIRE(moved_small == big);
+        REQUIRE(moved_big.empty());
+        REQUIRE(moved_big.isInline());
+    }
+
+    SECTION("BigNum across inline capacity") {
+        /// 10^180 has 21 cells, one more than kept inline
+        const auto big = BigNum("1" + std::string(180, '0'));
+        const auto half = BigNum("1" + std::string(90, '0'));
+        REQUIRE(half * half == big);
+        REQUIRE(big / half == half);
+        REQUIRE(big - 1_bn + 1_bn == big);
+    }
+}